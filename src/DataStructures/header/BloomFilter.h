@@ -0,0 +1,67 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+#include <utility>
+
+// Blocked Bloom filter over precomputed key hashes.
+//
+// Every key sets its k bits inside a single 512-bit block (one cache line),
+// so a membership test costs one memory access however large the filter is.
+// A negative answer is definite; a positive one is wrong with roughly the
+// configured false-positive rate while no more than designedCapacity() keys
+// have been added. Bits cannot be cleared: owners rebuild the filter after
+// enough removals.
+class BlockedBloomFilter
+{
+private:
+    static const int BLOCK_BITS = 512;
+
+    struct alignas(64) Block
+    {
+        uint64_t words[BLOCK_BITS / 64];
+    };
+
+    std::vector<Block> blocks;
+    int hashCount; // bits set per key
+    size_t capacity;
+    double targetRate;
+    size_t added;   // add() calls since the last clear()
+    size_t removed; // keys the owner has removed since then (their bits stay set)
+
+    static uint64_t mix(size_t hash);
+
+public:
+    BlockedBloomFilter(size_t expectedKeys, double falsePositiveRate);
+
+    void add(size_t hash);
+    bool mightContain(size_t hash) const;
+    void clear();
+
+    // Bits cannot be cleared, so owners only report removals; once
+    // needsRebuild() the filter should be rebuilt from the live keys
+    void noteRemoval() { removed++; }
+    bool needsRebuild() const { return added > capacity || removed * 2 > added; }
+
+    size_t designedCapacity() const { return capacity; }
+    double falsePositiveTarget() const { return targetRate; }
+    size_t memoryBytes() const { return blocks.size() * sizeof(Block); }
+};
+
+// True for tables with enableBloomFilter(), so managers can turn the filter
+// on where their storage supports it
+template <typename Table, typename = void>
+struct SupportsBloomFilter : std::false_type
+{
+};
+
+template <typename Table>
+struct SupportsBloomFilter<Table, std::void_t<decltype(std::declval<Table &>().enableBloomFilter(0.01))>>
+    : std::true_type
+{
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef BOOK_SNAPSHOT_H
+#define BOOK_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../entities/header/book.h"
+using namespace std;
+
+// Binary catalog snapshot that is memory-mapped read-only and queried in
+// place, with no parsing or per-book allocation on open.
+//
+// Layout (native byte order, every section 8-byte aligned):
+//
+//   SnapshotHeader
+//   uint32_t bucketStarts[bucketCount + 1]  first record of each bucket
+//   SnapshotRecord records[bookCount]       grouped by bucket
+//   char strings[stringsBytes]              title/author/publisher heap
+//
+// Every reference is an offset from the start of the file or of a section,
+// so the file can be mapped at any address.
+
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader
+{
+    char magic[8]; // "LIBSNAP"
+    uint32_t version;
+    uint32_t headerBytes;
+    uint64_t fileBytes;
+    uint64_t bookCount;
+    uint64_t bucketCount; // power of two
+    uint64_t bucketsOffset;
+    uint64_t recordsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsBytes;
+    uint64_t dataChecksum;   // everything after the header
+    uint64_t headerChecksum; // the fields above
+};
+
+struct SnapshotRecord
+{
+    int32_t id;
+    int32_t year;
+    uint32_t titleOffset, titleLength; // into the string heap
+    uint32_t authorOffset, authorLength;
+    uint32_t publisherOffset, publisherLength;
+};
+
+// Collects books and writes them out as a snapshot file
+class BookSnapshotWriter
+{
+private:
+    vector<SnapshotRecord> records;
+    string strings;
+
+    void appendString(const string &text, uint32_t &offset, uint32_t &length);
+
+public:
+    void add(const Book &book);
+    int size() const { return (int)records.size(); }
+
+    // Writes to filename + ".tmp" and renames it over filename, so a reader
+    // never maps a half-written file. Returns false on I/O failure.
+    bool write(const string &filename);
+};
+
+// Read-only view of a mapped snapshot file
+class BookSnapshot
+{
+private:
+    const unsigned char *base; // start of the mapping
+    size_t length;
+    const SnapshotHeader *header;
+    const uint32_t *bucketStarts;
+    const SnapshotRecord *records;
+    const char *strings;
+    string path;
+
+    bool validateLayout() const;
+    string_view stringAt(uint32_t offset, uint32_t length) const;
+
+public:
+    BookSnapshot();
+    ~BookSnapshot();
+
+    BookSnapshot(const BookSnapshot &) = delete;
+    BookSnapshot &operator=(const BookSnapshot &) = delete;
+
+    // Maps the file and checks its header and section bounds, which is
+    // O(1) in the catalog size. verifyChecksum additionally reads the whole
+    // file once to check its data checksum.
+    bool open(const string &filename, bool verifyChecksum = false);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+    const string &getPath() const { return path; }
+
+    // The record for an ID, or nullptr
+    const SnapshotRecord *find(int id) const;
+
+    // Strings are views into the mapping, valid until close()
+    string_view title(const SnapshotRecord &record) const { return stringAt(record.titleOffset, record.titleLength); }
+    string_view author(const SnapshotRecord &record) const { return stringAt(record.authorOffset, record.authorLength); }
+    string_view publisher(const SnapshotRecord &record) const { return stringAt(record.publisherOffset, record.publisherLength); }
+    Book toBook(const SnapshotRecord &record) const;
+
+    // Calls visit(record) for every record in file order
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    int size() const { return header ? (int)header->bookCount : 0; }
+
+    // Recomputes the data checksum over the mapped file
+    bool verify() const;
+
+    // Shared by writer and reader
+    static uint64_t checksum(const unsigned char *data, size_t bytes);
+    static uint64_t bucketOf(int id, uint64_t bucketCount);
+};
+
+template <typename Visitor>
+void BookSnapshot::forEach(Visitor visit) const
+{
+    for (int i = 0; i < size(); i++)
+        visit(records[i]);
+}
+
+#endif
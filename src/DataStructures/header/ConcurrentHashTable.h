@@ -0,0 +1,55 @@
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+
+#include <string>
+#include <vector>
+#include <shared_mutex>
+#include "HashTable.h"
+using namespace std;
+
+// Thread-safe hash table built from lock-striped segments.
+//
+// Keys are spread over STRIPE_COUNT independent HashTables (each owning its
+// own group of buckets and its own node allocator). Every stripe has a
+// reader/writer lock: search takes it shared, insert/update/remove take it
+// exclusive, so readers only contend with writers touching the same stripe.
+template <typename K, typename V>
+class ConcurrentHashTable
+{
+private:
+    static const int STRIPE_COUNT = 64; // power of two
+
+    // Padded to a cache line so neighbouring locks do not falsely share
+    struct alignas(64) Stripe
+    {
+        mutable shared_mutex lock;
+        HashTable<K, V> table;
+    };
+
+    Stripe *stripes;
+
+    // Picks a stripe from the high bits of a multiplicative hash, leaving the
+    // low bits (which the stripe's own table uses) independent of the choice
+    static int stripeOf(size_t hash);
+
+public:
+    ConcurrentHashTable();
+    ~ConcurrentHashTable();
+
+    ConcurrentHashTable(const ConcurrentHashTable &) = delete;
+    ConcurrentHashTable &operator=(const ConcurrentHashTable &) = delete;
+
+    bool insert(const K &key, const V &value);
+    bool update(const K &key, const V &newValue);
+    bool remove(const K &key);
+
+    // Copies the value out while the stripe is locked; false if not found.
+    // There is no pointer lookup: a pointer into a stripe would outlive the
+    // lock and dangle on the next update, remove or resize of that stripe.
+    bool search(const K &key, V &out) const;
+
+    vector<pair<K, V>> getAllEntries() const;
+    int size() const;
+};
+
+#endif
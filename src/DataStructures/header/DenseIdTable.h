@@ -0,0 +1,89 @@
+#ifndef DENSE_ID_TABLE_H
+#define DENSE_ID_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include "HashTable.h"
+#include "HashPolicies.h"
+using namespace std;
+
+// Integer-keyed store for mostly dense IDs (accession numbers).
+//
+// Values live contiguously in one vector. In direct mode an ID in
+// [baseId, baseId + slotOf.size()) is found with a bounds check and one load
+// from slotOf; IDs outside that range (sparse outliers) go through a small
+// HashTable. When the IDs are too sparse for a direct array to pay off, the
+// table runs in hashed mode and every ID goes through the hash table.
+//
+// bulkLoad() picks the mode from the ID density of the whole batch; single
+// inserts extend the direct range upward while it stays dense enough.
+// Exposes the same interface as HashTable for int keys. As with
+// FlatHashTable, pointers returned by search() are invalidated by a later
+// insert or remove.
+template <typename V>
+class DenseIdTable
+{
+private:
+    static constexpr double MIN_DENSITY = 0.5; // IDs per direct slot for direct mode
+    static const int SMALL_RANGE = 1024;       // always dense enough below this many slots
+    static constexpr int32_t NO_SLOT = -1;
+
+    vector<V> records;      // contiguous values
+    vector<int> recordIds;  // ID of records[i]
+    vector<int32_t> slotOf; // direct index: ID - baseId -> record slot or NO_SLOT
+    int baseId;
+    bool direct;
+    HashTable<int, int> outliers; // ID -> record slot for IDs outside the direct range
+
+    // Record slot for an ID, or NO_SLOT
+    int32_t slotFor(int id) const;
+    void setSlot(int id, int32_t slot);
+    bool inDirectRange(int id) const { return direct && (uint64_t)((int64_t)id - baseId) < slotOf.size(); }
+    bool extendsDirectRange(int id) const;
+
+    // Chooses direct or hashed mode for `ids` (plus the stored IDs) and rebuilds the index
+    void plan(const vector<int> &ids);
+    void reindex();
+
+public:
+    DenseIdTable();
+
+    DenseIdTable(const DenseIdTable &) = delete;
+    DenseIdTable &operator=(const DenseIdTable &) = delete;
+
+    // Returns false (and leaves the table unchanged) if the ID is already present
+    bool insert(const int &id, const V &value);
+    bool insert(const int &id, V &&value);
+    V *search(const int &id);
+    const V *search(const int &id) const;
+    bool update(const int &id, const V &newValue);
+    bool remove(const int &id);
+
+    // Sizes the store for the whole batch and picks direct or hashed mode
+    // from its ID density. Returns the number of new IDs added.
+    int bulkLoad(vector<pair<int, V>> &&entries, DuplicatePolicy policy = DuplicatePolicy::KeepLast);
+
+    // Snapshot copy of every entry; prefer forEach() for scans
+    vector<pair<int, V>> getAllEntries() const;
+
+    // Calls visit(id, value) for every entry, walking the contiguous vector
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    int size() const { return (int)records.size(); }
+
+    // Storage mode report
+    bool isDirect() const { return direct; }
+    int directSlots() const { return direct ? (int)slotOf.size() : 0; }
+    int outlierCount() const { return outliers.size(); }
+};
+
+template <typename V>
+template <typename Visitor>
+void DenseIdTable<V>::forEach(Visitor visit) const
+{
+    for (size_t i = 0; i < records.size(); i++)
+        visit(recordIds[i], records[i]);
+}
+
+#endif
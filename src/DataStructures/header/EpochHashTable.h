@@ -0,0 +1,106 @@
+#ifndef EPOCH_HASH_TABLE_H
+#define EPOCH_HASH_TABLE_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include "EpochReclaimer.h"
+#include "HashPolicies.h"
+using namespace std;
+
+// Chaining hash table whose lookups take no locks and perform no atomic
+// read-modify-writes.
+//
+// Writers are serialized by a mutex and never modify a node a reader can
+// see: insert publishes a fully built node with a release store, update
+// swaps in a fresh copy, remove unlinks, and growth publishes a rebuilt
+// bucket array. Replaced nodes and arrays are retired to the epoch domain
+// and freed only after every reader that could hold them has left.
+//
+// Readers that run concurrently with writers must hold an EpochGuard for as
+// long as they use a pointer returned by search(). Values must not be
+// modified through that pointer; use update().
+template <typename K, typename V>
+class EpochHashTable
+{
+private:
+    struct Node
+    {
+        K key;
+        V value;
+        atomic<Node *> next;
+
+        template <typename KArg, typename VArg>
+        Node(KArg &&k, VArg &&v, Node *n) : key(std::forward<KArg>(k)), value(std::forward<VArg>(v)), next(n) {}
+    };
+
+    struct Buckets
+    {
+        int capacity; // power of two
+        atomic<Node *> *heads;
+    };
+
+    atomic<Buckets *> current;
+    atomic<int> count;
+    double maxLoadFactor;
+
+    mutex writeLock;
+    RetireList retired;
+
+    static Buckets *allocateBuckets(int capacity);
+    static void deleteNode(void *node);
+    static void deleteBuckets(void *buckets); // frees the array and every node in it
+    static void deleteBucketArray(void *buckets); // frees the array only
+
+    static int indexFor(size_t hash, int capacity) { return (int)(hash & (size_t)(capacity - 1)); }
+    Node *findNode(const K &key) const;
+    void growIfNeeded(int incoming = 1); // caller holds writeLock
+
+public:
+    EpochHashTable(int initialCapacity = 16, double maxLoadFactor = 0.75);
+    ~EpochHashTable();
+
+    EpochHashTable(const EpochHashTable &) = delete;
+    EpochHashTable &operator=(const EpochHashTable &) = delete;
+
+    bool insert(const K &key, const V &value);
+    V *search(const K &key);
+    bool update(const K &key, const V &newValue);
+    bool remove(const K &key);
+
+    static size_t hashOf(const K &key);
+
+    // Loads a batch under one writer lock after growing once, resolving
+    // repeated keys by policy. Returns the number of new keys added.
+    int bulkLoad(vector<pair<K, V>> &&entries, DuplicatePolicy policy = DuplicatePolicy::KeepLast);
+
+    // Snapshot copy of every entry; prefer forEach() for scans
+    vector<pair<K, V>> getAllEntries() const;
+
+    // Calls visit(key, value) for every entry inside one read section
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    int size() const { return count.load(memory_order_relaxed); }
+    int bucketCount() const { return current.load(memory_order_acquire)->capacity; }
+    double loadFactor() const { return (double)size() / bucketCount(); }
+
+    // Retired nodes still waiting for readers to leave
+    int pendingReclaim() const { return retired.pendingCount(); }
+};
+
+template <typename K, typename V>
+template <typename Visitor>
+void EpochHashTable<K, V>::forEach(Visitor visit) const
+{
+    EpochGuard guard;
+    Buckets *b = current.load(memory_order_acquire);
+    for (int i = 0; i < b->capacity; i++)
+    {
+        for (Node *n = b->heads[i].load(memory_order_acquire); n; n = n->next.load(memory_order_acquire))
+            visit(n->key, n->value);
+    }
+}
+
+#endif
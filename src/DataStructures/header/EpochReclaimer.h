@@ -0,0 +1,89 @@
+#ifndef EPOCH_RECLAIMER_H
+#define EPOCH_RECLAIMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Epoch-based reclamation for lock-free readers.
+//
+// A reader announces the global epoch in its own cache-line-sized slot on
+// entry (a plain store and a fence, no read-modify-write) and clears it on
+// exit. Writers unlink nodes and retire them tagged with the current epoch;
+// the global epoch only advances once every active reader has announced it,
+// so anything retired two epochs ago can no longer be referenced and is
+// freed.
+class EpochDomain
+{
+private:
+    static const int MAX_READER_THREADS = 128;
+
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> epoch; // 0 while the thread is outside a read section
+        std::atomic<bool> claimed;
+    };
+
+    std::atomic<uint64_t> globalEpoch;
+    ReaderSlot slots[MAX_READER_THREADS];
+
+    EpochDomain();
+
+    ReaderSlot &slotForThisThread();
+    friend struct EpochThreadState;
+
+public:
+    // Process-wide domain shared by every epoch-protected structure
+    static EpochDomain &global();
+
+    void enter();
+    void exit();
+
+    uint64_t currentEpoch() const { return globalEpoch.load(std::memory_order_acquire); }
+
+    // Bumps the global epoch if every active reader has observed it and
+    // returns the (possibly new) epoch
+    uint64_t tryAdvance();
+};
+
+// RAII read-side critical section. Pointers obtained from an epoch-protected
+// structure stay valid until the guard is destroyed. Guards nest.
+class EpochGuard
+{
+public:
+    EpochGuard() { EpochDomain::global().enter(); }
+    ~EpochGuard() { EpochDomain::global().exit(); }
+
+    EpochGuard(const EpochGuard &) = delete;
+    EpochGuard &operator=(const EpochGuard &) = delete;
+};
+
+// Objects unlinked by a writer and waiting for their grace period.
+// Not thread-safe; the owning structure serializes its writers.
+class RetireList
+{
+private:
+    struct Retired
+    {
+        void *ptr;
+        void (*deleter)(void *);
+        uint64_t epoch;
+    };
+
+    std::vector<Retired> pending;
+
+public:
+    ~RetireList() { drain(); }
+
+    void retire(void *ptr, void (*deleter)(void *));
+
+    // Frees everything whose grace period has passed
+    void reclaim();
+
+    // Frees everything; only valid once no reader can be active
+    void drain();
+
+    int pendingCount() const { return (int)pending.size(); }
+};
+
+#endif
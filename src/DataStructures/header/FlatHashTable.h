@@ -0,0 +1,204 @@
+#ifndef FLAT_HASH_TABLE_H
+#define FLAT_HASH_TABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "KeyView.h"
+#include "HashPolicies.h"
+using namespace std;
+
+// Open-addressing hash table in the style of SwissTable.
+//
+// Slots live in one flat array next to a parallel array of control bytes.
+// A control byte is EMPTY, DELETED (tombstone) or, for a full slot, the low
+// 7 bits of the key's hash. Lookups probe groups of 16 control bytes and,
+// where SSE2 is available, compare a whole group against the hash tag in a
+// single instruction, touching a slot only on a tag match.
+//
+// Exposes the same interface as HashTable. Unlike HashTable, pointers
+// returned by search() are invalidated by a later insert that rehashes.
+// Hash picks the hash functor (see HashPolicies.h); probing always mixes it
+// again, so StdHash is fine even for sequential keys.
+template <typename K, typename V, typename Hash = StdHash>
+class FlatHashTable
+{
+private:
+    static const int GROUP_WIDTH = 16;
+    static const int8_t CTRL_EMPTY = -128;  // 0b10000000
+    static const int8_t CTRL_DELETED = -2;  // 0b11111110
+
+    struct Slot
+    {
+        K key;
+        V value;
+    };
+
+    int8_t *ctrl; // capacity control bytes, one per slot
+    Slot *slots;  // raw storage, constructed only where ctrl is full
+    int capacity; // always a multiple of GROUP_WIDTH and a power of two
+    int count;
+    int tombstones;
+
+    // hashOf() value -> well-mixed hash used for group index and tag
+    static size_t mix(size_t hash);
+    static size_t hashKey(const K &key) { return mix(hashOf(key)); }
+    static int8_t tagOf(size_t hash) { return (int8_t)(hash & 0x7F); }
+    static bool isFull(int8_t c) { return c >= 0; }
+
+    int groupCount() const { return capacity / GROUP_WIDTH; }
+    int firstGroup(size_t hash) const { return (int)((hash >> 7) & (groupCount() - 1)); }
+
+    // Bitmask of positions in the group at `base` whose control byte equals `tag`
+    uint32_t matchTag(int base, int8_t tag) const;
+    uint32_t matchEmpty(int base) const;
+    uint32_t matchEmptyOrDeleted(int base) const;
+
+    template <typename Q>
+    int findIndex(const Q &key, size_t mixedHash) const;
+    int findIndex(const K &key) const { return findIndex(key, hashKey(key)); }
+    void eraseAt(int index);
+    int findInsertSlot(size_t hash) const;
+
+    void allocate(int newCapacity);
+    void resize(int newCapacity);
+    void rehashInPlace();
+    void reserveOne();
+
+    // Reserves room and marks the slot for a new key with hashOf() value
+    // `hash` as full; the caller constructs the Slot there
+    int claimSlot(size_t hash);
+
+public:
+    // std::string_view for string-keyed tables (see KeyView.h)
+    typedef typename KeyViewOf<K>::type KeyView;
+
+    FlatHashTable(int initialCapacity = 16);
+    ~FlatHashTable();
+
+    FlatHashTable(const FlatHashTable &) = delete;
+    FlatHashTable &operator=(const FlatHashTable &) = delete;
+
+    // Returns false (and leaves the table unchanged) if the key is already present
+    bool insert(const K &key, const V &value);
+    V *search(const K &key);
+    bool update(const K &key, const V &newValue);
+    bool remove(const K &key);
+
+    // Move-aware overloads: the value (and key) are moved into the slot
+    bool insert(const K &key, V &&value);
+    bool insert(K &&key, V &&value);
+    bool update(const K &key, V &&newValue);
+
+    // Builds the value in place from args; like insert(), returns false and
+    // leaves the table unchanged if the key is already present
+    template <typename KArg, typename... Args>
+    bool emplace(KArg &&key, Args &&...args);
+
+    // Builds the value in place only if the key is absent. Returns the stored
+    // value and whether it was inserted.
+    template <typename KArg, typename... Args>
+    pair<V *, bool> try_emplace(KArg &&key, Args &&...args);
+
+    // Loads a batch in one pass after growing the slot array once, resolving
+    // repeated keys by policy. Returns the number of new keys added.
+    int bulkLoad(vector<pair<K, V>> &&entries, DuplicatePolicy policy = DuplicatePolicy::KeepLast);
+
+    // Heterogeneous lookup: probe a string-keyed table without building a std::string
+    V *search(KeyView key);
+    bool remove(KeyView key);
+
+    // Precomputed-hash lookup, interchangeable with a HashTable that uses the
+    // same Hash policy
+    static size_t hashOf(const K &key);
+    static size_t hashOf(KeyView key);
+    V *search(const K &key, size_t hash);
+    V *search(KeyView key, size_t hash);
+
+    // Snapshot copy of every entry; prefer forEach()/iterators for scans
+    vector<pair<K, V>> getAllEntries() const;
+
+    // Forward iterator over full slots, yielding them in place (slot.key / slot.value)
+    class const_iterator
+    {
+    private:
+        const FlatHashTable *owner;
+        int index;
+
+        void settle()
+        {
+            while (index < owner->capacity && !isFull(owner->ctrl[index]))
+                index++;
+        }
+
+    public:
+        const_iterator(const FlatHashTable *owner, int index) : owner(owner), index(index) { settle(); }
+
+        const Slot &operator*() const { return owner->slots[index]; }
+        const Slot *operator->() const { return &owner->slots[index]; }
+
+        const_iterator &operator++()
+        {
+            index++;
+            settle();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const { return index == other.index && owner == other.owner; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity); }
+
+    // Calls visit(key, value) for every entry without copying anything
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    int size() const { return count; }
+    int bucketCount() const { return capacity; }
+    double loadFactor() const { return capacity ? (double)count / capacity : 0.0; }
+};
+
+template <typename K, typename V, typename Hash>
+template <typename KArg, typename... Args>
+bool FlatHashTable<K, V, Hash>::emplace(KArg &&key, Args &&...args)
+{
+    return try_emplace(std::forward<KArg>(key), std::forward<Args>(args)...).second;
+}
+
+template <typename K, typename V, typename Hash>
+template <typename KArg, typename... Args>
+pair<V *, bool> FlatHashTable<K, V, Hash>::try_emplace(KArg &&key, Args &&...args)
+{
+    if constexpr (!std::is_same<typename std::decay<KArg>::type, K>::value)
+    {
+        return try_emplace(K(std::forward<KArg>(key)), std::forward<Args>(args)...);
+    }
+    else
+    {
+        size_t hash = hashOf(key);
+        if (V *existing = search(key, hash))
+            return make_pair(existing, false);
+
+        int target = claimSlot(hash); // may reallocate slots
+        Slot *slot = &slots[target];
+        new (slot) Slot{K(std::forward<KArg>(key)), V(std::forward<Args>(args)...)};
+        return make_pair(&slot->value, true);
+    }
+}
+
+template <typename K, typename V, typename Hash>
+template <typename Visitor>
+void FlatHashTable<K, V, Hash>::forEach(Visitor visit) const
+{
+    for (int i = 0; i < capacity; i++)
+        if (isFull(ctrl[i]))
+            visit(slots[i].key, slots[i].value);
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef HASH_POLICIES_H
+#define HASH_POLICIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Which entry survives when bulkLoad() meets a key more than once, whether
+// the repeat is inside the batch or already stored in the table
+enum class DuplicatePolicy
+{
+    KeepFirst, // the earliest value wins; later ones are dropped
+    KeepLast   // the latest value wins, overwriting earlier ones
+};
+
+// -----------HASH POLICIES-----------
+// Hash functors are transparent (templated on the probe type), so a
+// string-keyed table can also hash a std::string_view for heterogeneous
+// lookups; equal characters give equal hashes.
+
+// std::hash as is. For integers libstdc++ returns the value itself.
+struct StdHash
+{
+    template <typename Q>
+    size_t operator()(const Q &key) const { return std::hash<Q>()(key); }
+};
+
+// std::hash followed by a 64-bit finalizer (from MurmurHash3), so every
+// input bit affects the low and high bits alike. Use with MaskReduction or
+// FastRangeReduction whenever keys are sequential or strided.
+struct MixedHash
+{
+    template <typename Q>
+    size_t operator()(const Q &key) const
+    {
+        uint64_t h = (uint64_t)std::hash<Q>()(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return (size_t)h;
+    }
+};
+
+// -----------REDUCTION POLICIES-----------
+// Map a hash onto [0, buckets). roundCapacity() adjusts a requested bucket
+// count to one the reduction supports; the table only ever doubles or
+// halves it afterwards.
+
+// hash % buckets: any bucket count, one integer division per probe
+struct ModuloReduction
+{
+    static size_t index(size_t hash, size_t buckets) { return hash % buckets; }
+    static int roundCapacity(int buckets) { return buckets; }
+};
+
+// hash & (buckets - 1): power-of-two bucket counts, uses only the low bits
+struct MaskReduction
+{
+    static size_t index(size_t hash, size_t buckets) { return hash & (buckets - 1); }
+    static int roundCapacity(int buckets)
+    {
+        int cap = 1;
+        while (cap < buckets)
+            cap *= 2;
+        return cap;
+    }
+};
+
+// Lemire's fastrange: (h * buckets) >> 32 on a 32-bit fold of the hash.
+// Any bucket count and no division, but it relies on the high bits, so the
+// hash must be well mixed (pair it with MixedHash).
+struct FastRangeReduction
+{
+    static size_t index(size_t hash, size_t buckets)
+    {
+        uint32_t folded = (uint32_t)((uint64_t)hash ^ ((uint64_t)hash >> 32));
+        return (size_t)(((uint64_t)folded * (uint64_t)buckets) >> 32);
+    }
+    static int roundCapacity(int buckets) { return buckets; }
+};
+
+#endif
@@ -3,6 +3,14 @@
 
 #include <string>
 #include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <atomic>
+#include "SlabAllocator.h"
+#include "BloomFilter.h"
+#include "KeyView.h"
+#include "HashPolicies.h"
 using namespace std;
 
 template <typename K, typename V>
@@ -12,28 +20,282 @@ struct HashNode
     V value;
     HashNode *next;
 
-    HashNode(K k, V v);
+    // Key and value are forwarded straight into the members, so an rvalue
+    // is moved and emplace() arguments build the value in place
+    template <typename KArg, typename... Args>
+    HashNode(KArg &&k, Args &&...args)
+        : key(std::forward<KArg>(k)), value(std::forward<Args>(args)...), next(nullptr) {}
 };
 
-template <typename K, typename V>
+// Bucket distribution snapshot returned by HashTable::stats()
+struct HashTableStats
+{
+    int size;
+    int buckets;
+    double loadFactor;
+    int emptyBuckets;
+    int maxChain;
+    double meanChain; // over non-empty buckets
+    int p99Chain;     // 99% of non-empty buckets have a chain at most this long
+    vector<int> histogram; // histogram[n] = number of buckets holding n entries
+};
+
+// Separate-chaining hash table that grows and shrinks with its load factor.
+// Resizing is incremental: while a rehash is in progress both bucket arrays
+// are live and every operation migrates a few old buckets into the new one,
+// so no single insert pays for moving the whole table.
+//
+// Nodes come from Alloc (SlabAllocator by default, HeapAllocator for plain
+// new/delete); see SlabAllocator.h. Hash and Reduce pick the hash functor
+// and how it is mapped onto a bucket; see HashPolicies.h.
+//
+// An optional blocked Bloom filter (enableBloomFilter()) answers lookups
+// for absent keys without touching a bucket.
+template <typename K, typename V, typename Alloc = SlabAllocator,
+          typename Hash = StdHash, typename Reduce = ModuloReduction>
 class HashTable
 {
 private:
-    static const int TABLE_SIZE = 1000;
-    HashNode<K, V> *table[TABLE_SIZE];
+    static const int DEFAULT_CAPACITY = 16;
+    static const int REHASH_STEP = 4; // old buckets migrated per operation
+
+    HashNode<K, V> **table; // active bucket array
+    int capacity;
+
+    HashNode<K, V> **oldTable; // bucket array being drained (nullptr when not rehashing)
+    int oldCapacity;
+    int rehashIndex; // next bucket of oldTable to migrate
+
+    int count;
+    double maxLoadFactor;
+
+    Alloc nodeAllocator;
+
+    BlockedBloomFilter *bloom; // nullptr unless enableBloomFilter() was called
+    double bloomTarget;
+    mutable atomic<long long> bloomSkipped; // const readers may run concurrently
+
+    template <typename... Args>
+    HashNode<K, V> *createNode(Args &&...args);
+    void destroyNode(HashNode<K, V> *node);
+    void linkNode(HashNode<K, V> *node, size_t hash); // into the active array
+
+    int hashFunction(const K &key, int buckets) const;
+    static int bucketFor(size_t hash, int buckets) { return (int)Reduce::index(hash, (size_t)buckets); }
 
-    int hashFunction(const K &key);
+    // Shared lookup/removal paths for K and KeyView probes with a known hash
+    template <typename Q>
+    static size_t hashKey(const Q &key);
+    template <typename Q>
+    HashNode<K, V> *findNode(const Q &key, size_t hash) const;
+    template <typename Q>
+    bool removeNode(const Q &key, size_t hash);
+
+    void startRehash(int newCapacity);
+    void rehashStep();
+    void finishRehash();
+    void checkGrow();
+    void checkShrink();
+
+    // Replaces the filter with one sized for expectedKeys, filled from the live keys
+    void rebuildBloomFilter(size_t expectedKeys);
 
 public:
-    HashTable();
+    // std::string_view for string-keyed tables (see KeyView.h)
+    typedef typename KeyViewOf<K>::type KeyView;
+
+    HashTable(int initialCapacity = DEFAULT_CAPACITY, double maxLoadFactor = 0.75);
     ~HashTable();
 
+    HashTable(const HashTable &) = delete;
+    HashTable &operator=(const HashTable &) = delete;
+
     bool insert(const K &key, const V &value);
     V *search(const K &key);
     bool update(const K &key, const V &newValue);
     bool remove(const K &key);
 
+    // Move-aware overloads: the value (and key) are moved into the node
+    bool insert(const K &key, V &&value);
+    bool insert(K &&key, V &&value);
+    bool update(const K &key, V &&newValue);
+
+    // Builds the value in place from args; like insert(), does not check for
+    // an existing key
+    template <typename KArg, typename... Args>
+    bool emplace(KArg &&key, Args &&...args);
+
+    // Builds the value in place only if the key is absent. Returns the stored
+    // value and whether it was inserted.
+    template <typename KArg, typename... Args>
+    pair<V *, bool> try_emplace(KArg &&key, Args &&...args);
+
+    // Loads a batch in one pass: sizes the bucket array and node slab once,
+    // then moves every entry in, resolving repeated keys (in the batch or
+    // already stored) by policy. Returns the number of new keys added.
+    int bulkLoad(vector<pair<K, V>> &&entries, DuplicatePolicy policy = DuplicatePolicy::KeepLast);
+
+    // Heterogeneous lookup: probe a string-keyed table without building a std::string
+    V *search(KeyView key);
+    bool remove(KeyView key);
+
+    // Precomputed-hash lookup: hash a key once with hashOf() and reuse it
+    // across every table (HashTable or FlatHashTable) with the same key type
+    // and Hash policy; a hash from another policy finds nothing
+    static size_t hashOf(const K &key);
+    static size_t hashOf(KeyView key);
+    V *search(const K &key, size_t hash);
+    V *search(KeyView key, size_t hash);
+
+    // Read-only lookup that does not advance an in-progress rehash, so any
+    // number of threads may call it concurrently while no writer is active
+    const V *search(const K &key) const;
+    const V *search(const K &key, size_t hash) const;
+
+    // Snapshot copy of every entry; prefer forEach()/iterators for scans
     vector<pair<K, V>> getAllEntries() const;
+
+    // Forward iterator yielding each live node in place (node.key / node.value).
+    // Does not advance an in-progress rehash, so the table is left untouched.
+    class const_iterator
+    {
+    private:
+        const HashTable *owner;
+        bool inOldTable; // walking the not-yet-migrated tail of oldTable
+        int bucket;
+        const HashNode<K, V> *node;
+
+        // Moves to the first node at or after the current bucket
+        void settle()
+        {
+            while (!node)
+            {
+                if (!inOldTable)
+                {
+                    if (++bucket < owner->capacity)
+                    {
+                        node = owner->table[bucket];
+                        continue;
+                    }
+                    inOldTable = true;
+                    bucket = owner->rehashIndex - 1;
+                }
+                if (!owner->oldTable || ++bucket >= owner->oldCapacity)
+                    return;
+                node = owner->oldTable[bucket];
+            }
+        }
+
+    public:
+        // The end iterator is any position with no node
+        const_iterator(const HashTable *owner, bool atEnd)
+            : owner(owner), inOldTable(false), bucket(-1), node(nullptr)
+        {
+            if (!atEnd)
+                settle();
+        }
+
+        const HashNode<K, V> &operator*() const { return *node; }
+        const HashNode<K, V> *operator->() const { return node; }
+
+        const_iterator &operator++()
+        {
+            node = node->next;
+            settle();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const { return node == other.node && owner == other.owner; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, false); }
+    const_iterator end() const { return const_iterator(this, true); }
+
+    // Calls visit(key, value) for every entry without copying anything
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    // Sizing information
+    int size() const { return count; }
+    int bucketCount() const { return capacity; }
+    double loadFactor() const { return capacity ? (double)count / capacity : 0.0; }
+    double getMaxLoadFactor() const { return maxLoadFactor; }
+    void setMaxLoadFactor(double factor);
+    bool isRehashing() const { return oldTable != nullptr; }
+
+    // Chain-length distribution, to check the hash/reduction policies on real keys
+    HashTableStats stats() const;
+
+    // Negative-lookup filter. Kept in sync on insert; removals leave stale
+    // bits behind, and the filter is rebuilt once they (or growth past its
+    // sizing) would push the false-positive rate above the target.
+    void enableBloomFilter(double falsePositiveRate = 0.01);
+    void disableBloomFilter();
+    bool hasBloomFilter() const { return bloom != nullptr; }
+    size_t bloomMemoryBytes() const { return bloom ? bloom->memoryBytes() : 0; }
+
+    // Lookups and removals answered by the filter alone
+    long long bloomSkippedProbes() const { return bloomSkipped.load(memory_order_relaxed); }
 };
 
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename... Args>
+HashNode<K, V> *HashTable<K, V, Alloc, Hash, Reduce>::createNode(Args &&...args)
+{
+    void *mem = nodeAllocator.allocate(sizeof(HashNode<K, V>));
+    return new (mem) HashNode<K, V>(std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename KArg, typename... Args>
+bool HashTable<K, V, Alloc, Hash, Reduce>::emplace(KArg &&key, Args &&...args)
+{
+    if constexpr (!std::is_same<typename std::decay<KArg>::type, K>::value)
+    {
+        return emplace(K(std::forward<KArg>(key)), std::forward<Args>(args)...);
+    }
+    else
+    {
+        // Hash before the key is forwarded (and possibly moved from)
+        size_t hash = hashOf(key);
+        rehashStep();
+        linkNode(createNode(std::forward<KArg>(key), std::forward<Args>(args)...), hash);
+        return true;
+    }
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename KArg, typename... Args>
+pair<V *, bool> HashTable<K, V, Alloc, Hash, Reduce>::try_emplace(KArg &&key, Args &&...args)
+{
+    if constexpr (!std::is_same<typename std::decay<KArg>::type, K>::value)
+    {
+        return try_emplace(K(std::forward<KArg>(key)), std::forward<Args>(args)...);
+    }
+    else
+    {
+        size_t hash = hashOf(key);
+        if (V *existing = search(key, hash))
+            return make_pair(existing, false);
+
+        HashNode<K, V> *node = createNode(std::forward<KArg>(key), std::forward<Args>(args)...);
+        linkNode(node, hash);
+        return make_pair(&node->value, true);
+    }
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename Visitor>
+void HashTable<K, V, Alloc, Hash, Reduce>::forEach(Visitor visit) const
+{
+    for (int i = 0; i < capacity; i++)
+        for (HashNode<K, V> *entry = table[i]; entry; entry = entry->next)
+            visit(entry->key, entry->value);
+
+    for (int i = rehashIndex; oldTable && i < oldCapacity; i++)
+        for (HashNode<K, V> *entry = oldTable[i]; entry; entry = entry->next)
+            visit(entry->key, entry->value);
+}
+
 #endif
@@ -0,0 +1,149 @@
+#ifndef HISTORY_LOG_H
+#define HISTORY_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "HashTable.h"
+using namespace std;
+
+// Append-only log of borrow history events ("user,title,date,action").
+//
+// Each event is a 12-byte record of interned string IDs, stored in
+// fixed-size chunks that are allocated once and never moved, so an append
+// never copies earlier events and costs one allocation per CHUNK_EVENTS
+// events. User names, titles, dates and actions are each stored once in a
+// string pool however often they recur. Events are addressed by index,
+// oldest first; iterate with rbegin()/rend() for most recent first.
+class HistoryLog
+{
+public:
+    // One event as string views into the log's pools, valid as long as the log
+    struct Entry
+    {
+        string_view user;
+        string_view title; // the whole text for a note
+        string_view date;
+        string_view action;
+        bool note; // free-form line added through appendNote()
+
+        // The event as a history line, "user,title,date,action"
+        string toLine() const;
+    };
+
+private:
+    static const int CHUNK_EVENTS = 4096;          // 48 KB per chunk
+    static const uint32_t NOTE_USER = UINT32_MAX;  // user ID marking a note
+    static const uint32_t MAX_DATES = 1u << 24;    // date IDs share a word with the action
+    static const uint32_t MAX_ACTIONS = 1u << 8;
+
+    struct Event
+    {
+        uint32_t user;
+        uint32_t title;
+        uint32_t dateAndAction; // date ID << 8 | action ID
+    };
+
+    // Interns strings; a deque keeps every stored string (and so every view
+    // handed out) in place as the pool grows
+    struct StringPool
+    {
+        deque<string> strings;
+        HashTable<string_view, int> ids;
+
+        uint32_t intern(string_view text);
+        string_view at(uint32_t id) const { return strings[id]; }
+        size_t size() const { return strings.size(); }
+    };
+
+    vector<Event *> chunks;
+    size_t count;
+
+    StringPool names;   // users and titles
+    StringPool dates;
+    StringPool actions;
+
+    Event &push();
+
+public:
+    HistoryLog();
+    ~HistoryLog();
+
+    HistoryLog(const HistoryLog &) = delete;
+    HistoryLog &operator=(const HistoryLog &) = delete;
+
+    void append(string_view user, string_view title, string_view date, string_view action);
+
+    // Free-form line, shown as is
+    void appendNote(string_view text);
+
+    // Event at position index (0 = oldest); index must be below size()
+    Entry operator[](size_t index) const;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Distinct strings held across the pools
+    size_t internedStrings() const { return names.size() + dates.size() + actions.size(); }
+
+    // Bidirectional iterator by index; dereferences to an Entry by value
+    class const_iterator
+    {
+    private:
+        const HistoryLog *log;
+        size_t index;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Entry value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Entry *pointer;
+        typedef Entry reference;
+
+        const_iterator(const HistoryLog *log = nullptr, size_t index = 0) : log(log), index(index) {}
+
+        Entry operator*() const { return (*log)[index]; }
+
+        const_iterator &operator++()
+        {
+            index++;
+            return *this;
+        }
+
+        const_iterator &operator--()
+        {
+            index--;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            index++;
+            return previous;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator previous = *this;
+            index--;
+            return previous;
+        }
+
+        bool operator==(const const_iterator &other) const { return index == other.index && log == other.log; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef KEY_VIEW_H
+#define KEY_VIEW_H
+
+#include <string>
+#include <string_view>
+
+// Borrowed key type accepted by the hash tables' heterogeneous lookups.
+// String-keyed tables can be probed with a std::string_view, so callers do
+// not have to build a std::string; for every other key type the view is a
+// placeholder that cannot be constructed from anything useful, which keeps
+// the overloads out of the way.
+struct NoKeyView
+{
+};
+
+template <typename K>
+struct KeyViewOf
+{
+    typedef NoKeyView type;
+};
+
+template <>
+struct KeyViewOf<std::string>
+{
+    typedef std::string_view type;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef LOAN_LIST_H
+#define LOAN_LIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+using namespace std;
+
+// Which of a loan's two lists a LoanList threads through
+enum LoanSide
+{
+    BY_USER = 0, // the borrower's active loans
+    BY_BOOK = 1  // the book's active borrowers
+};
+
+// One active loan. It is a node of two intrusive doubly-linked lists at
+// once, its user's and its book's, so it can be unlinked from both in O(1)
+// once found, without searching either list.
+struct Loan
+{
+    string user;
+    string title;
+    string date;
+    Loan *prev[2]; // indexed by LoanSide
+    Loan *next[2];
+
+    Loan(const string &user, const string &title, const string &date)
+        : user(user), title(title), date(date), prev{nullptr, nullptr}, next{nullptr, nullptr} {}
+};
+
+// Doubly-linked list of loans through one side's links. The list does not
+// own its loans; the owner allocates them, links each into a BY_USER and a
+// BY_BOOK list, and unlinks it from both before freeing it.
+class LoanList
+{
+private:
+    Loan *head;
+    Loan *tail;
+    int count;
+    int side;
+
+public:
+    explicit LoanList(int side = BY_USER) : head(nullptr), tail(nullptr), count(0), side(side) {}
+
+    void pushBack(Loan *loan);
+    // O(1): the loan must be in this list
+    void unlink(Loan *loan);
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Loan &front() const { return *head; }
+
+    // Forward iterator over the loans, oldest first
+    class const_iterator
+    {
+    private:
+        const Loan *loan;
+        int side;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Loan value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Loan *pointer;
+        typedef const Loan &reference;
+
+        const_iterator(const Loan *loan, int side) : loan(loan), side(side) {}
+
+        const Loan &operator*() const { return *loan; }
+        const Loan *operator->() const { return loan; }
+
+        const_iterator &operator++()
+        {
+            loan = loan->next[side];
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const { return loan == other.loan; }
+        bool operator!=(const const_iterator &other) const { return loan != other.loan; }
+    };
+
+    const_iterator begin() const { return const_iterator(head, side); }
+    const_iterator end() const { return const_iterator(nullptr, side); }
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef RADIX_TRIE_H
+#define RADIX_TRIE_H
+
+#include "SlabAllocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Node kinds, smallest first; a node is replaced by the next kind up when
+// its children outgrow it
+enum RadixNodeType : uint8_t
+{
+    RADIX_LEAF = 0, // no children
+    RADIX_NODE4 = 1,
+    RADIX_NODE16 = 2,
+    RADIX_NODE48 = 3,
+    RADIX_NODE256 = 4
+};
+
+// Common node header. label is the run of key bytes the node absorbs after
+// the byte its parent branched on (path compression), kept in the trie's
+// label pool as an (offset, length) pair.
+struct RadixNode
+{
+    uint8_t type;
+    bool isEnd;
+    uint16_t childCount;
+    uint32_t labelOffset;
+    uint32_t labelLength;
+    uint32_t weight;    // the key's rank weight, if isEnd
+    uint32_t maxWeight; // highest weight of any key in the subtree
+    uint32_t count;     // references to the key (isEnd while non-zero)
+    uint32_t postings;  // 1 + the key's slot in the trie's ID lists (0 = no IDs)
+};
+
+// Up to 4 children, keys sorted
+struct RadixNode4 : RadixNode
+{
+    uint8_t keys[4];
+    RadixNode *children[4];
+};
+
+// Up to 16 children, keys sorted
+struct RadixNode16 : RadixNode
+{
+    uint8_t keys[16];
+    RadixNode *children[16];
+};
+
+// Up to 48 children; childIndex maps a byte to its slot + 1 (0 = none)
+struct RadixNode48 : RadixNode
+{
+    uint8_t childIndex[256];
+    RadixNode *children[48];
+};
+
+// One slot per byte
+struct RadixNode256 : RadixNode
+{
+    RadixNode *children[256];
+};
+
+// Path-compressed (radix) trie with adaptive node sizes in the style of an
+// adaptive radix tree: a node takes 4, 16, 48 or 256 child slots depending
+// on how many it needs, and chains of single-child nodes collapse into one
+// node with a label. Drop-in for Trie (same insert()/getAutoComplete(),
+// same lowercase ASCII keys and result order) at a fraction of its memory.
+// Nodes of each kind come from a size class of the trie's own slabs, so
+// destroying it frees the slabs rather than every node.
+class RadixTrie
+{
+private:
+    SlabAllocator nodeAllocator;
+    RadixNode *root;
+    vector<char> labels; // every node label; a split only narrows a label, so labels are never copied
+    int keyCount;
+    size_t nodeBytes;
+
+    // Book IDs of keys inserted with them, one list per key; a key's list
+    // is recycled through freePostings once its last reference goes
+    vector<vector<int>> postingLists;
+    vector<uint32_t> freePostings;
+
+    // The key byte for c: lowercase ASCII, or -1 for anything else
+    static int keyByte(char c);
+
+    RadixNode *newNode(RadixNodeType type, uint32_t labelOffset, uint32_t labelLength);
+    void freeNode(RadixNode *node);
+
+    // Slot holding the child for byte, or nullptr
+    static RadixNode **findChild(RadixNode *node, uint8_t byte);
+    // Adds a child, growing *slot into a larger node kind when it is full
+    void addChild(RadixNode **slot, uint8_t byte, RadixNode *child);
+    void grow(RadixNode **slot);
+    // Unlinks the child for byte (the node keeps its kind)
+    static void removeChild(RadixNode *node, uint8_t byte);
+
+    // Leaf for key[from..], its bytes appended to the label pool
+    RadixNode *newLeaf(const string &key, size_t from);
+
+    // Node where prefix ends, with path set to the prefix plus the rest of
+    // that node's label; nullptr if no key starts with prefix
+    const RadixNode *findPrefix(const string &prefix, string &path) const;
+
+    // Node holding word as a key, or nullptr; ancestors gets the nodes on the way down
+    RadixNode *findKey(const string &word, vector<RadixNode *> *ancestors);
+
+    // maxWeight from the node's own weight and its children's maxima
+    static void refreshMaxWeight(RadixNode *node);
+
+    // path holds the completion up to and including node's label
+    void collect(const RadixNode *node, string &path, vector<string> &results) const;
+
+    // Top k keys by weight below any of roots (a node and the text spelling
+    // it through its label), appended to out as (weight, completion),
+    // heaviest first and equal weights in title order
+    void bestFirst(const vector<pair<const RadixNode *, string>> &roots, int k, vector<pair<uint32_t, string>> &out) const;
+
+public:
+    RadixTrie();
+    ~RadixTrie();
+
+    RadixTrie(const RadixTrie &) = delete;
+    RadixTrie &operator=(const RadixTrie &) = delete;
+
+    // A new key gets weight 0; inserting an existing key adds a reference
+    // to it and keeps its weight
+    void insert(const string &word);
+
+    // Drops one reference to word; the last one removes the key and frees
+    // the nodes left without keys. Nodes are not merged back or shrunk.
+    // False if word is not a key.
+    bool remove(const string &word);
+
+    // References to word (0 if it is not a key)
+    int count(const string &word) const;
+
+    // As insert() and remove(), for a reference that carries a book ID.
+    // remove() is false if id is not one of word's.
+    void insert(const string &word, int id);
+    bool remove(const string &word, int id);
+    // IDs carried by word's references, in no particular order
+    vector<int> idsOf(const string &word) const;
+    vector<string> getAutoComplete(const string &prefix) const;
+
+    // The k completions of prefix with the highest weights, highest first;
+    // among equal weights the smallest titles are kept, in order.
+    // Best-first over the subtree maxima, so the cost depends on k and key
+    // length, not on how many keys share the prefix.
+    vector<string> getAutoComplete(const string &prefix, int k) const;
+
+    // Up to k keys starting with something within maxEdits edits
+    // (Levenshtein) of prefix, ranked as StaticTrie::getFuzzyAutoComplete()
+    vector<string> getFuzzyAutoComplete(const string &prefix, int maxEdits, int k) const;
+
+    // Sets the rank weight of an existing key; false if word is not a key
+    bool setWeight(const string &word, uint32_t weight);
+    // 0 if word is not a key
+    uint32_t weightOf(const string &word) const;
+
+    // Distinct keys stored
+    int size() const { return keyCount; }
+
+    // Bytes held by nodes and labels
+    size_t memoryBytes() const { return nodeBytes + labels.capacity(); }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <cstddef>
+
+// Node allocators used by HashTable, LinkedList and the tries.
+//
+// Both expose allocate(size) / deallocate(ptr, size) / reserve(size, n) /
+// releaseAll() and a RELEASES_IN_BULK flag. When the flag is set the owning container may skip
+// per-node deallocate() on destruction and hand everything back with one
+// releaseAll() call.
+
+// Plain global new/delete, one call per node (the original behaviour)
+class HeapAllocator
+{
+public:
+    static const bool RELEASES_IN_BULK = false;
+
+    void *allocate(size_t size) { return ::operator new(size); }
+    void deallocate(void *ptr, size_t) { ::operator delete(ptr); }
+    void reserve(size_t, size_t) {}
+    void releaseAll() {}
+};
+
+// Per-container slab allocator with size-class free lists.
+//
+// Requests are rounded up to a 16-byte size class. Each class carves blocks
+// out of slabs that double in size (8 blocks up to 1024) and recycles freed
+// blocks through an intrusive free list, so steady insert/remove churn never
+// reaches malloc. releaseAll() frees one allocation per slab.
+class SlabAllocator
+{
+private:
+    static const size_t ALIGNMENT = 16;
+    static const size_t MAX_CLASS_SIZE = 4096; // larger requests get a dedicated block; a 256-pointer trie node fits
+    static const size_t FIRST_SLAB_BLOCKS = 8;
+    static const size_t MAX_SLAB_BLOCKS = 1024;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct Slab
+    {
+        Slab *next;
+    };
+
+    // Header in front of an oversized request, so releaseAll() can still find it
+    struct LargeBlock
+    {
+        LargeBlock *prev;
+        LargeBlock *next;
+    };
+
+    struct SizeClass
+    {
+        size_t blockSize;
+        FreeBlock *freeList;
+        char *bumpPtr; // unused tail of the newest slab
+        char *bumpEnd;
+        size_t nextSlabBlocks;
+        SizeClass *next;
+    };
+
+    SizeClass *classes; // usually a single class per container
+    Slab *slabs;        // every slab owned by this allocator
+    LargeBlock *large;  // oversized blocks still outstanding
+
+    SizeClass *classFor(size_t blockSize);
+    void addSlab(SizeClass *sc, size_t blocks);
+
+public:
+    static const bool RELEASES_IN_BULK = true;
+
+    SlabAllocator();
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+    // Moving hands every slab (and so every outstanding block) to the new owner
+    SlabAllocator(SlabAllocator &&other) noexcept;
+    SlabAllocator &operator=(SlabAllocator &&other) noexcept;
+
+    void *allocate(size_t size);
+    void deallocate(void *ptr, size_t size);
+
+    // Makes sure the next `blocks` allocations of `size` bytes are served
+    // without another trip to operator new (one slab sized to fit)
+    void reserve(size_t size, size_t blocks);
+
+    // Frees every slab at once; all outstanding blocks become invalid
+    void releaseAll();
+};
+
+#endif
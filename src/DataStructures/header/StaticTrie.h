@@ -0,0 +1,138 @@
+#ifndef STATIC_TRIE_H
+#define STATIC_TRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Immutable LOUDS-encoded (level-order unary degree sequence) trie, built
+// once from a batch of keys.
+//
+// Nodes are numbered in breadth-first order and described by flat arrays
+// only: the degree bits (one 1 per child and a closing 0 per node), the
+// byte each node is reached by, and a terminal bit. Children of a node are
+// consecutive numbers, found from the position of its closing 0, so a
+// lookup touches a few words per level and costs under 2 bytes per node.
+// The arrays hold no pointers. Keys and result order are those of Trie.
+//
+// The shape is fixed, but keys carry reference counts: remove() drops a
+// reference and a key with none left stays in place as a tombstone,
+// skipped by every query, until addRef() revives it or the next build()
+// leaves it out.
+class StaticTrie
+{
+private:
+    static const int ZERO_SAMPLE = 128; // select0 sample interval
+
+    vector<uint64_t> louds;         // per node: 1 per child, then 0
+    vector<uint32_t> zeroSamples;   // bit position of every ZERO_SAMPLE-th 0
+    vector<uint8_t> labels;         // byte leading into each node (root: 0)
+    vector<uint64_t> terminal;      // bit per node: a key ends here
+    vector<uint32_t> terminalRank;  // terminal bits before each word of terminal
+
+    // Rank weights; both empty until some key has a non-zero weight
+    vector<uint32_t> keyWeights;    // per key, in node order (indexed by terminal rank)
+    vector<uint32_t> subtreeMax;    // per node: highest key weight below it
+
+    // References per key (indexed by terminal rank); empty while every key has exactly one
+    vector<uint32_t> keyCounts;
+
+    // Book IDs, if the build had them: key i owns the slots from
+    // postingStart[i] to postingStart[i + 1], its live references first
+    vector<uint32_t> postingStart;
+    vector<int> postings;
+    size_t bitCount;
+    int keyCount;      // live keys
+    int terminalCount; // live keys plus tombstones
+
+    void appendBit(bool one);
+    bool isTerminal(uint32_t node) const { return (terminal[node / 64] >> (node % 64)) & 1; }
+    // A terminal node whose key has not been removed
+    bool isLive(uint32_t node) const { return isTerminal(node) && (keyCounts.empty() || keyCounts[keyIndex(node)] > 0); }
+    // Index of a terminal node among the terminal nodes
+    uint32_t keyIndex(uint32_t node) const;
+    uint32_t ownWeight(uint32_t node) const;
+    // subtreeMax[node] from its own weight and its children's maxima
+    void refreshSubtreeMax(uint32_t node);
+
+    // Position of the k-th 0 bit (k from 0)
+    size_t select0(size_t k) const;
+    // Position of the first 0 bit at or after pos
+    size_t nextZero(size_t pos) const;
+    // Children of node are [first, first + count), in byte order
+    void children(uint32_t node, uint32_t &first, uint32_t &count) const;
+    // Child of node reached by byte, or 0 (the root is nobody's child)
+    uint32_t findChild(uint32_t node, uint8_t byte) const;
+
+    // Node where prefix ends (0 for the root), or -1
+    long long findPrefix(const string &prefix) const;
+    // Terminal node for word (live or not), or -1; ancestors gets the nodes on the way down
+    long long findKey(const string &word, vector<uint32_t> *ancestors) const;
+
+    void collect(uint32_t start, string &path, vector<string> &results) const;
+
+    // Top k keys by weight below any of roots (a node and the text spelling
+    // it), appended to out as (weight, completion), heaviest first and
+    // equal weights in title order
+    void bestFirst(const vector<pair<uint32_t, string>> &roots, int k, vector<pair<uint32_t, string>> &out) const;
+
+public:
+    StaticTrie();
+
+    // Replaces the contents with words (any order, duplicates allowed).
+    // weights, if given, pairs with words; a repeated key keeps its highest
+    // and gets a reference per occurrence. ids, if given, also pairs with
+    // words: each reference then carries the ID of its book.
+    void build(const vector<string> &words, const vector<uint32_t> &weights = vector<uint32_t>(),
+               const vector<int> &ids = vector<int>());
+
+    // Adds a reference to word, reviving it if it was removed. False if
+    // word was never built in (it needs a rebuild, or another trie).
+    bool addRef(const string &word);
+    // Drops a reference to word; with none left the key becomes a
+    // tombstone and loses its weight. False if word is not a live key.
+    bool remove(const string &word);
+    // References to word (0 if it is not a live key)
+    int count(const string &word) const;
+
+    // The ID overloads keep a trie built with IDs in step. A key has room
+    // for as many IDs as it was built with, so addRef() is false once they
+    // are all live (or if word was never built in); remove() is false if
+    // id is not one of word's.
+    bool addRef(const string &word, int id);
+    bool remove(const string &word, int id);
+    // IDs carried by word's live references, in no particular order
+    vector<int> idsOf(const string &word) const;
+    vector<string> getAutoComplete(const string &prefix) const;
+
+    // The k completions of prefix with the highest weights, highest first
+    // and ties by title, found best-first over the subtree maxima (see RadixTrie)
+    vector<string> getAutoComplete(const string &prefix, int k) const;
+
+    // Up to k keys starting with something within maxEdits edits
+    // (Levenshtein) of prefix: closest first, then by weight, then by
+    // title. Completions are spelled as stored (lowercase). Branches that
+    // can no longer match are cut as soon as the edit budget runs out.
+    vector<string> getFuzzyAutoComplete(const string &prefix, int maxEdits, int k) const;
+
+    // Sets the rank weight of a live key; false if word is not one
+    bool setWeight(const string &word, uint32_t weight);
+    // 0 if word is not a key
+    uint32_t weightOf(const string &word) const;
+
+    // Distinct live keys
+    int size() const { return keyCount; }
+
+    // Removed keys still taking space until the next build()
+    int tombstones() const { return terminalCount - keyCount; }
+
+    int nodeCount() const { return (int)labels.size(); }
+
+    // Bytes held by the arrays
+    size_t memoryBytes() const;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include "HashTable.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Inverted index for substring ("contains") queries. Every run of three
+// bytes of a lowercased text is a trigram, and each trigram keeps the
+// sorted IDs of the texts containing it. A text containing a term contains
+// all of the term's trigrams, so intersecting their lists, shortest first,
+// leaves a few candidates to check instead of every text. The candidates
+// are a superset: the trigrams can all be there without the term being
+// there, so callers confirm each one.
+class TrigramIndex
+{
+private:
+    HashTable<int, vector<int>> *postings; // trigram (3 bytes packed) -> sorted IDs
+
+    // The distinct trigrams of text, lowercased
+    static vector<int> trigramsOf(const string &text);
+
+public:
+    // Terms shorter than this have no trigram to look up
+    static const int MIN_TERM_LENGTH = 3;
+
+    TrigramIndex();
+    ~TrigramIndex();
+
+    TrigramIndex(const TrigramIndex &) = delete;
+    TrigramIndex &operator=(const TrigramIndex &) = delete;
+
+    // Indexes text under id, or removes it (pass the text it was added
+    // with). O(text length) lookups; adding the highest ID so far appends,
+    // any other insert or remove shifts the rest of the list.
+    void add(int id, const string &text);
+    void remove(int id, const string &text);
+    void clear();
+
+    // IDs of the texts that may contain term (case-insensitive), ascending.
+    // False, with out untouched, if term is shorter than MIN_TERM_LENGTH.
+    bool candidates(const string &term, vector<int> &out) const;
+
+    // Distinct trigrams indexed
+    int trigramCount() const { return postings->size(); }
+
+    // Bytes held by the ID lists
+    size_t memoryBytes() const;
+};
+
+#endif
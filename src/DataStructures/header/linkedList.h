@@ -1,6 +1,11 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 #include <vector>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include "SlabAllocator.h"
 
 using namespace std;
 
@@ -10,14 +15,26 @@ struct Node
     T data;
     Node *next;
 
-    Node(T val) : data(val), next(nullptr) {}
+    template <typename... Args>
+    Node(Args &&...args) : data(std::forward<Args>(args)...), next(nullptr) {}
 };
 
-template <typename T>
+// Singly linked list whose nodes come from Alloc (see SlabAllocator.h).
+// Keeps a tail pointer and its length, so appends and size() are O(1).
+template <typename T, typename Alloc = SlabAllocator>
 class LinkedList
 {
 private:
     Node<T> *head;
+    Node<T> *tail;
+    int count;
+    Alloc nodeAllocator;
+
+    template <typename... Args>
+    Node<T> *createNode(Args &&...args);
+    void destroyNode(Node<T> *node);
+    void appendNode(Node<T> *node);
+    void destroyAll(); // frees every node and the allocator's slabs
 
 public:
     LinkedList();
@@ -25,11 +42,93 @@ public:
     LinkedList &operator=(const LinkedList &other);
     ~LinkedList();
 
+    // Moving takes over the nodes together with the allocator that owns them,
+    // so no element is copied or reallocated
+    LinkedList(LinkedList &&other) noexcept;
+    LinkedList &operator=(LinkedList &&other) noexcept;
+
     void insertAtEnd(const T &data);
+    void insertAtEnd(T &&data);
+
+    // Constructs the element directly inside the new node
+    template <typename... Args>
+    void emplaceAtEnd(Args &&...args);
+
     bool remove(const T &data);
     bool search(const T &data);
     void clear();
+
+    // Snapshot copy of every element; prefer iterating the list in place
     std::vector<T> toVector() const;
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Forward iterators over the elements in insertion order. Removing an
+    // element invalidates only iterators to that element.
+    template <typename Value>
+    class basic_iterator
+    {
+    private:
+        Node<T> *node;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        explicit basic_iterator(Node<T> *node = nullptr) : node(node) {}
+
+        Value &operator*() const { return node->data; }
+        Value *operator->() const { return &node->data; }
+
+        basic_iterator &operator++()
+        {
+            node = node->next;
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            basic_iterator previous = *this;
+            node = node->next;
+            return previous;
+        }
+
+        bool operator==(const basic_iterator &other) const { return node == other.node; }
+        bool operator!=(const basic_iterator &other) const { return node != other.node; }
+    };
+
+    typedef basic_iterator<T> iterator;
+    typedef basic_iterator<const T> const_iterator;
+
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+
+    // First and last elements; the list must not be empty
+    T &front() { return head->data; }
+    const T &front() const { return head->data; }
+    T &back() { return tail->data; }
+    const T &back() const { return tail->data; }
 };
 
+template <typename T, typename Alloc>
+template <typename... Args>
+Node<T> *LinkedList<T, Alloc>::createNode(Args &&...args)
+{
+    void *mem = nodeAllocator.allocate(sizeof(Node<T>));
+    return new (mem) Node<T>(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void LinkedList<T, Alloc>::emplaceAtEnd(Args &&...args)
+{
+    appendNode(createNode(std::forward<Args>(args)...));
+}
+
 #endif
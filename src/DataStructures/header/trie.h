@@ -1,6 +1,9 @@
 #ifndef TRIE_H
 #define TRIE_H
 
+#include "SlabAllocator.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 using namespace std;
@@ -9,24 +12,116 @@ class TrieNode
 {
 public:
     TrieNode *children[128]; // Support ASCII characters
-    bool isEnd;
+    uint64_t childMask[2];   // bit per non-null child, so traversal skips empty slots
+    int count;               // times the key ending here was inserted, less removals (0 = not a key)
 
     TrieNode();
 };
 
+// One level of an iterative traversal: the node and the next child byte to try
+struct TrieFrame
+{
+    const TrieNode *node;
+    int next;
+};
+
+// Position of a paged completion query. Reuse one cursor across queries:
+// it owns the path buffer and traversal stack, so once they have grown to
+// the longest key a query allocates nothing.
+class TrieCursor
+{
+private:
+    friend class Trie;
+
+    string prefix;            // query being paged through
+    string path;              // completion being built; after a page, the last one emitted
+    vector<TrieFrame> stack;  // path from the prefix node down
+    bool started;
+    bool emitStart;           // the prefix node itself is a key not yet emitted
+    bool finished;
+
+public:
+    TrieCursor() : started(false), emitStart(false), finished(false) {}
+
+    // Starts over on the next query; the buffers are kept
+    void reset()
+    {
+        started = false;
+        finished = false;
+    }
+
+    // False once every completion of the query has been emitted
+    bool hasMore() const { return !finished; }
+};
+
+// Nodes are carved out of slabs owned by the trie (see SlabAllocator.h):
+// an insert is mostly a pointer bump, and destroying or clearing the trie
+// frees a handful of large blocks instead of walking every node.
 class Trie
 {
 private:
+    SlabAllocator nodeAllocator;
     TrieNode *root;
 
+    TrieNode *newNode();
+    void freeNode(TrieNode *node);
+
 public:
     Trie();
+    ~Trie();
+
+    Trie(const Trie &) = delete;
+    Trie &operator=(const Trie &) = delete;
+
+    // Inserting a key again adds a reference to it
     void insert(const string &word);
+
+    // Drops one reference to word; once none are left the key goes, along
+    // with the nodes no other key uses. O(length of word). False if word
+    // is not a key.
+    bool remove(const string &word);
+
+    // Removes every key, releasing all node memory at once (for a rebuild)
+    void clear();
     vector<string> getAutoComplete(const string &prefix);
 
+    // Emits completions of prefix to sink(const string &) in the order of
+    // getAutoComplete(), at most limit of them (0 = all). A fresh cursor, or
+    // one last used for another prefix, starts at the first completion;
+    // otherwise the page resumes after the last completion the cursor
+    // emitted, even if keys were inserted in between. The string passed to
+    // sink is the cursor's buffer, valid only during the call. Returns the
+    // number emitted.
+    template <typename Sink>
+    size_t forEachCompletion(const string &prefix, TrieCursor &cursor, Sink &&sink, size_t limit = 0) const
+    {
+        if (!open(prefix, cursor))
+            return 0;
+        size_t emitted = 0;
+        while ((limit == 0 || emitted < limit) && advance(cursor))
+        {
+            const string &completion = cursor.path;
+            sink(completion);
+            emitted++;
+        }
+        if (!cursor.finished && !pending(cursor))
+            cursor.finished = true;
+        return emitted;
+    }
+
 private:
-    void collect(TrieNode *node, string prefix, vector<string> &results);
-    TrieNode *searchPrefix(const string &prefix);
+    TrieNode *searchPrefix(const string &prefix) const;
+
+    // First child byte of node at or after from, or -1
+    static int nextChild(const TrieNode *node, int from);
+
+    // Positions cursor for prefix (fresh, or just past its last completion);
+    // false if there is nothing left to emit
+    bool open(const string &prefix, TrieCursor &cursor) const;
+    // Moves to the next completion, leaving it in cursor.path; false at the end
+    bool advance(TrieCursor &cursor) const;
+    // Whether a completion remains after the cursor's position
+    bool pending(const TrieCursor &cursor) const;
 };
 
 #endif
@@ -0,0 +1,80 @@
+#include "../header/BloomFilter.h"
+#include <cmath>
+
+BlockedBloomFilter::BlockedBloomFilter(size_t expectedKeys, double falsePositiveRate)
+    : capacity(expectedKeys > 0 ? expectedKeys : 1),
+      targetRate(falsePositiveRate > 0 && falsePositiveRate < 1 ? falsePositiveRate : 0.01),
+      added(0), removed(0)
+{
+    // Optimal bits per key for a classic filter, plus 20% because keys are
+    // confined to one block and blocks fill unevenly
+    const double ln2 = 0.6931471805599453;
+    double bitsPerKey = -std::log(targetRate) / (ln2 * ln2);
+
+    hashCount = (int)std::lround(bitsPerKey * ln2);
+    if (hashCount < 1)
+        hashCount = 1;
+    if (hashCount > 16)
+        hashCount = 16;
+
+    size_t bits = (size_t)std::ceil(capacity * bitsPerKey * 1.2);
+    size_t blockCount = (bits + BLOCK_BITS - 1) / BLOCK_BITS;
+    blocks.resize(blockCount > 0 ? blockCount : 1);
+    clear();
+}
+
+// Table hashes may be the identity (std::hash<int>), so remix before use
+uint64_t BlockedBloomFilter::mix(size_t hash)
+{
+    uint64_t h = (uint64_t)hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// The high half picks the block; the low half drives double hashing of
+// the k bit positions inside it
+void BlockedBloomFilter::add(size_t hash)
+{
+    uint64_t h = mix(hash);
+    Block &block = blocks[(size_t)(((h >> 32) * (uint64_t)blocks.size()) >> 32)];
+
+    uint32_t bit = (uint32_t)h;
+    uint32_t step = (bit >> 16) | 1;
+    for (int i = 0; i < hashCount; i++)
+    {
+        uint32_t pos = bit & (BLOCK_BITS - 1);
+        block.words[pos >> 6] |= 1ULL << (pos & 63);
+        bit += step;
+    }
+    added++;
+}
+
+bool BlockedBloomFilter::mightContain(size_t hash) const
+{
+    uint64_t h = mix(hash);
+    const Block &block = blocks[(size_t)(((h >> 32) * (uint64_t)blocks.size()) >> 32)];
+
+    uint32_t bit = (uint32_t)h;
+    uint32_t step = (bit >> 16) | 1;
+    for (int i = 0; i < hashCount; i++)
+    {
+        uint32_t pos = bit & (BLOCK_BITS - 1);
+        if (!(block.words[pos >> 6] & (1ULL << (pos & 63))))
+            return false;
+        bit += step;
+    }
+    return true;
+}
+
+void BlockedBloomFilter::clear()
+{
+    for (Block &block : blocks)
+        for (uint64_t &word : block.words)
+            word = 0;
+    added = 0;
+    removed = 0;
+}
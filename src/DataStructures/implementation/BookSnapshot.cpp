@@ -0,0 +1,311 @@
+#include "../header/BookSnapshot.h"
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = {'L', 'I', 'B', 'S', 'N', 'A', 'P', '\0'};
+
+static uint64_t alignTo8(uint64_t offset)
+{
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+// -----------SHARED-----------
+// Word-at-a-time multiply/xor mix: fast enough to verify a few hundred MB
+// on demand, and any flipped byte changes the result
+uint64_t BookSnapshot::checksum(const unsigned char *data, size_t bytes)
+{
+    uint64_t h = 0x84222325cbf29ce4ULL ^ (uint64_t)bytes;
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        h ^= word;
+        h *= 0x9e3779b97f4a7c15ULL;
+        h ^= h >> 29;
+    }
+
+    uint64_t tail = 0;
+    memcpy(&tail, data + i, bytes - i);
+    h ^= tail;
+    h *= 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+// Fixed mix rather than std::hash, so the bucket of an ID does not depend
+// on the standard library that wrote the file
+uint64_t BookSnapshot::bucketOf(int id, uint64_t bucketCount)
+{
+    uint64_t h = (uint64_t)(uint32_t)id;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h & (bucketCount - 1);
+}
+
+// -----------WRITER-----------
+void BookSnapshotWriter::appendString(const string &text, uint32_t &offset, uint32_t &length)
+{
+    offset = (uint32_t)strings.size();
+    length = (uint32_t)text.size();
+    strings += text;
+}
+
+void BookSnapshotWriter::add(const Book &book)
+{
+    SnapshotRecord record;
+    record.id = book.getId();
+    record.year = book.getYear();
+    appendString(book.getTitle(), record.titleOffset, record.titleLength);
+    appendString(book.getAuthor(), record.authorOffset, record.authorLength);
+    appendString(book.getPublisher(), record.publisherOffset, record.publisherLength);
+    records.push_back(record);
+}
+
+bool BookSnapshotWriter::write(const string &filename)
+{
+    // Offsets and bucket starts are 32-bit
+    if (records.size() > UINT32_MAX || strings.size() > UINT32_MAX)
+        return false;
+
+    uint64_t bucketCount = 1;
+    while (bucketCount < records.size())
+        bucketCount *= 2;
+
+    // Counting sort of the records by bucket
+    vector<uint32_t> bucketStarts(bucketCount + 1, 0);
+    for (const SnapshotRecord &record : records)
+        bucketStarts[BookSnapshot::bucketOf(record.id, bucketCount) + 1]++;
+    for (uint64_t b = 0; b < bucketCount; b++)
+        bucketStarts[b + 1] += bucketStarts[b];
+
+    vector<uint32_t> next(bucketStarts.begin(), bucketStarts.end() - 1);
+    vector<SnapshotRecord> grouped(records.size());
+    for (const SnapshotRecord &record : records)
+        grouped[next[BookSnapshot::bucketOf(record.id, bucketCount)]++] = record;
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.headerBytes = sizeof(SnapshotHeader);
+    header.bookCount = records.size();
+    header.bucketCount = bucketCount;
+    header.bucketsOffset = alignTo8(sizeof(SnapshotHeader));
+    header.recordsOffset = alignTo8(header.bucketsOffset + bucketStarts.size() * sizeof(uint32_t));
+    header.stringsOffset = header.recordsOffset + grouped.size() * sizeof(SnapshotRecord);
+    header.stringsBytes = strings.size();
+    header.fileBytes = alignTo8(header.stringsOffset + header.stringsBytes);
+
+    // Build the image in memory so both checksums are known before writing
+    vector<unsigned char> image(header.fileBytes, 0);
+    memcpy(&image[header.bucketsOffset], bucketStarts.data(), bucketStarts.size() * sizeof(uint32_t));
+    if (!grouped.empty())
+        memcpy(&image[header.recordsOffset], grouped.data(), grouped.size() * sizeof(SnapshotRecord));
+    if (!strings.empty())
+        memcpy(&image[header.stringsOffset], strings.data(), strings.size());
+
+    header.dataChecksum = BookSnapshot::checksum(image.data() + sizeof(SnapshotHeader), image.size() - sizeof(SnapshotHeader));
+    header.headerChecksum = BookSnapshot::checksum((const unsigned char *)&header, offsetof(SnapshotHeader, headerChecksum));
+    memcpy(image.data(), &header, sizeof(header));
+
+    string tmpName = filename + ".tmp";
+    std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        return false;
+    out.write((const char *)image.data(), (std::streamsize)image.size());
+    out.close();
+    if (!out)
+    {
+        std::remove(tmpName.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    std::remove(filename.c_str());
+#endif
+    return std::rename(tmpName.c_str(), filename.c_str()) == 0;
+}
+
+// -----------READER-----------
+BookSnapshot::BookSnapshot()
+    : base(nullptr), length(0), header(nullptr), bucketStarts(nullptr), records(nullptr), strings(nullptr) {}
+
+BookSnapshot::~BookSnapshot()
+{
+    close();
+}
+
+// The file and mapping handles are closed as soon as the view exists; the
+// view alone keeps the mapping alive until close()
+bool BookSnapshot::open(const string &filename, bool verifyChecksum)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(SnapshotHeader))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+        return false;
+
+    base = (const unsigned char *)view;
+    length = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(SnapshotHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return false;
+
+    base = (const unsigned char *)view;
+    length = (size_t)info.st_size;
+#endif
+
+    header = (const SnapshotHeader *)base;
+    if (!validateLayout() || (verifyChecksum && !verify()))
+    {
+        close();
+        return false;
+    }
+
+    bucketStarts = (const uint32_t *)(base + header->bucketsOffset);
+    records = (const SnapshotRecord *)(base + header->recordsOffset);
+    strings = (const char *)(base + header->stringsOffset);
+    path = filename;
+    return true;
+}
+
+void BookSnapshot::close()
+{
+    if (!base)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile((void *)base);
+#else
+    munmap((void *)base, length);
+#endif
+
+    base = nullptr;
+    length = 0;
+    header = nullptr;
+    bucketStarts = nullptr;
+    records = nullptr;
+    strings = nullptr;
+    path.clear();
+}
+
+// Everything open() needs before trusting an offset, without touching the
+// sections themselves (apart from the last bucket start)
+bool BookSnapshot::validateLayout() const
+{
+    const SnapshotHeader &h = *header;
+    if (memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0 || h.version != SNAPSHOT_VERSION ||
+        h.headerBytes != sizeof(SnapshotHeader) || h.fileBytes != length)
+        return false;
+
+    if (h.headerChecksum != checksum(base, offsetof(SnapshotHeader, headerChecksum)))
+        return false;
+
+    // The checksum only catches accidents (anyone can recompute it), so every
+    // field is bounded as if hostile. Counts and offsets are capped by the
+    // file length first; each section is then compared with the room left
+    // after its offset, and nothing is added that could wrap around.
+    if (h.bucketCount == 0 || (h.bucketCount & (h.bucketCount - 1)) != 0 || h.bucketCount > length / sizeof(uint32_t) ||
+        h.bookCount > length / sizeof(SnapshotRecord) || h.stringsBytes > length)
+        return false;
+
+    if (h.bucketsOffset > length || h.recordsOffset > length || h.stringsOffset > length)
+        return false;
+
+    if (h.bucketsOffset < sizeof(SnapshotHeader) || h.bucketsOffset % 8 != 0 || h.recordsOffset % 8 != 0 ||
+        h.recordsOffset < h.bucketsOffset || h.stringsOffset < h.recordsOffset ||
+        (h.bucketCount + 1) * sizeof(uint32_t) > h.recordsOffset - h.bucketsOffset ||
+        h.bookCount * sizeof(SnapshotRecord) > h.stringsOffset - h.recordsOffset ||
+        h.stringsBytes > length - h.stringsOffset)
+        return false;
+
+    const uint32_t *starts = (const uint32_t *)(base + h.bucketsOffset);
+    return starts[0] == 0 && starts[h.bucketCount] == h.bookCount;
+}
+
+bool BookSnapshot::verify() const
+{
+    if (!base)
+        return false;
+    return header->dataChecksum == checksum(base + sizeof(SnapshotHeader), length - sizeof(SnapshotHeader));
+}
+
+// Bounds checks stay on the query path: a corrupted record yields no match
+// or an empty string, never a read outside the mapping
+const SnapshotRecord *BookSnapshot::find(int id) const
+{
+    if (!base)
+        return nullptr;
+
+    uint64_t bucket = bucketOf(id, header->bucketCount);
+    uint32_t start = bucketStarts[bucket];
+    uint32_t end = bucketStarts[bucket + 1];
+    if (start > end || end > header->bookCount)
+        return nullptr;
+
+    for (uint32_t i = start; i < end; i++)
+    {
+        if (records[i].id == id)
+            return &records[i];
+    }
+    return nullptr;
+}
+
+string_view BookSnapshot::stringAt(uint32_t offset, uint32_t length) const
+{
+    if ((uint64_t)offset + length > header->stringsBytes)
+        return string_view();
+    return string_view(strings + offset, length);
+}
+
+Book BookSnapshot::toBook(const SnapshotRecord &record) const
+{
+    return Book(record.id, string(title(record)), string(author(record)), record.year, string(publisher(record)));
+}
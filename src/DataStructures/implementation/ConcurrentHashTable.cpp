@@ -0,0 +1,104 @@
+#include "../header/ConcurrentHashTable.h"
+#include <functional>
+#include <mutex>
+#include <cstdint>
+
+template <typename K, typename V>
+ConcurrentHashTable<K, V>::ConcurrentHashTable()
+{
+    stripes = new Stripe[STRIPE_COUNT];
+}
+
+template <typename K, typename V>
+ConcurrentHashTable<K, V>::~ConcurrentHashTable()
+{
+    delete[] stripes;
+}
+
+template <typename K, typename V>
+int ConcurrentHashTable<K, V>::stripeOf(size_t hash)
+{
+    uint64_t x = (uint64_t)hash * 0x9E3779B97F4A7C15ULL;
+    return (int)(x >> 58); // top 6 bits -> 0..63
+}
+
+template <typename K, typename V>
+bool ConcurrentHashTable<K, V>::insert(const K &key, const V &value)
+{
+    size_t hash = HashTable<K, V>::hashOf(key);
+    Stripe &stripe = stripes[stripeOf(hash)];
+    unique_lock<shared_mutex> guard(stripe.lock);
+    return stripe.table.insert(key, value);
+}
+
+template <typename K, typename V>
+bool ConcurrentHashTable<K, V>::update(const K &key, const V &newValue)
+{
+    size_t hash = HashTable<K, V>::hashOf(key);
+    Stripe &stripe = stripes[stripeOf(hash)];
+    unique_lock<shared_mutex> guard(stripe.lock);
+
+    V *val = stripe.table.search(key, hash);
+    if (!val)
+        return false;
+    *val = newValue;
+    return true;
+}
+
+template <typename K, typename V>
+bool ConcurrentHashTable<K, V>::remove(const K &key)
+{
+    size_t hash = HashTable<K, V>::hashOf(key);
+    Stripe &stripe = stripes[stripeOf(hash)];
+    unique_lock<shared_mutex> guard(stripe.lock);
+    return stripe.table.remove(key);
+}
+
+// Readers use the const lookup, which never advances the stripe's
+// incremental rehash, so concurrent shared holders do not race.
+template <typename K, typename V>
+bool ConcurrentHashTable<K, V>::search(const K &key, V &out) const
+{
+    size_t hash = HashTable<K, V>::hashOf(key);
+    const Stripe &stripe = stripes[stripeOf(hash)];
+    shared_lock<shared_mutex> guard(stripe.lock);
+
+    const V *val = stripe.table.search(key, hash);
+    if (!val)
+        return false;
+    out = *val;
+    return true;
+}
+
+template <typename K, typename V>
+vector<pair<K, V>> ConcurrentHashTable<K, V>::getAllEntries() const
+{
+    vector<pair<K, V>> entries;
+    for (int i = 0; i < STRIPE_COUNT; i++)
+    {
+        shared_lock<shared_mutex> guard(stripes[i].lock);
+        stripes[i].table.forEach([&](const K &key, const V &value)
+                                 { entries.push_back(make_pair(key, value)); });
+    }
+    return entries;
+}
+
+template <typename K, typename V>
+int ConcurrentHashTable<K, V>::size() const
+{
+    int total = 0;
+    for (int i = 0; i < STRIPE_COUNT; i++)
+    {
+        shared_lock<shared_mutex> guard(stripes[i].lock);
+        total += stripes[i].table.size();
+    }
+    return total;
+}
+
+// -----------------------
+// Explicit template instantiation
+// -----------------------
+#include "../entities/header/book.h"
+
+template class ConcurrentHashTable<int, Book>; // catalog served from a thread pool
+template class ConcurrentHashTable<int, int>;  // benchmarks
@@ -0,0 +1,225 @@
+#include "../header/DenseIdTable.h"
+#include <algorithm>
+#include <utility>
+
+template <typename V>
+DenseIdTable<V>::DenseIdTable() : baseId(0), direct(true) {}
+
+// -----------INDEX-----------
+template <typename V>
+int32_t DenseIdTable<V>::slotFor(int id) const
+{
+    // Dense path: one bounds check and one load
+    if (inDirectRange(id))
+        return slotOf[(size_t)((int64_t)id - baseId)];
+
+    if (outliers.size() == 0)
+        return NO_SLOT;
+    const int *slot = outliers.search(id);
+    return slot ? *slot : NO_SLOT;
+}
+
+template <typename V>
+void DenseIdTable<V>::setSlot(int id, int32_t slot)
+{
+    if (inDirectRange(id))
+    {
+        slotOf[(size_t)((int64_t)id - baseId)] = slot;
+        return;
+    }
+
+    if (slot == NO_SLOT)
+        outliers.remove(id);
+    else if (int *existing = outliers.search(id))
+        *existing = slot;
+    else
+        outliers.insert(id, slot);
+}
+
+// An ID just past the direct range joins it if the range stays dense enough
+template <typename V>
+bool DenseIdTable<V>::extendsDirectRange(int id) const
+{
+    if (!direct || (int64_t)id < (int64_t)baseId + (int64_t)slotOf.size())
+        return false;
+
+    int64_t newRange = (int64_t)id - baseId + 1;
+    int64_t directCount = (int64_t)records.size() - outliers.size() + 1;
+    return newRange <= SMALL_RANGE || directCount >= MIN_DENSITY * newRange;
+}
+
+// Starts from the IDs between the 1st and 99th percentile, so a handful of
+// far-away IDs cannot make the whole array sparse, then widens the range
+// outward for as long as it stays dense enough. IDs left outside it become
+// outliers; if even the core is sparse, the table switches to hashed mode.
+template <typename V>
+void DenseIdTable<V>::plan(const vector<int> &ids)
+{
+    vector<int> all(recordIds);
+    all.insert(all.end(), ids.begin(), ids.end());
+    sort(all.begin(), all.end());
+    all.erase(unique(all.begin(), all.end()), all.end());
+
+    slotOf.clear();
+    direct = true;
+    baseId = 0;
+
+    if (!all.empty())
+    {
+        // Is a direct array over all[a..b] dense enough?
+        auto denseEnough = [&](size_t a, size_t b)
+        {
+            int64_t range = (int64_t)all[b] - all[a] + 1;
+            return range <= SMALL_RANGE || (double)(b - a + 1) >= MIN_DENSITY * range;
+        };
+
+        size_t n = all.size();
+        size_t first = n / 100;
+        size_t last = n - 1 - n / 100;
+
+        direct = denseEnough(first, last);
+        if (direct)
+        {
+            while (first > 0 && denseEnough(first - 1, last))
+                first--;
+            while (last < n - 1 && denseEnough(first, last + 1))
+                last++;
+
+            baseId = all[first];
+            slotOf.assign((size_t)((int64_t)all[last] - all[first] + 1), NO_SLOT);
+        }
+    }
+    reindex();
+}
+
+// Rebuilds slotOf and outliers for the current mode and range
+template <typename V>
+void DenseIdTable<V>::reindex()
+{
+    for (const pair<int, int> &entry : outliers.getAllEntries())
+        outliers.remove(entry.first);
+
+    for (size_t i = 0; i < records.size(); i++)
+        setSlot(recordIds[i], (int32_t)i);
+}
+
+// -----------PUBLIC API-----------
+template <typename V>
+bool DenseIdTable<V>::insert(const int &id, const V &value)
+{
+    V copy(value);
+    return insert(id, std::move(copy));
+}
+
+template <typename V>
+bool DenseIdTable<V>::insert(const int &id, V &&value)
+{
+    if (slotFor(id) != NO_SLOT)
+        return false;
+
+    // The first ID of an empty direct table anchors the range
+    if (direct && records.empty() && slotOf.empty())
+        baseId = id;
+
+    if (extendsDirectRange(id))
+        slotOf.resize((size_t)((int64_t)id - baseId + 1), NO_SLOT);
+
+    records.push_back(std::move(value));
+    recordIds.push_back(id);
+    setSlot(id, (int32_t)(records.size() - 1));
+    return true;
+}
+
+template <typename V>
+V *DenseIdTable<V>::search(const int &id)
+{
+    int32_t slot = slotFor(id);
+    return slot == NO_SLOT ? nullptr : &records[slot];
+}
+
+template <typename V>
+const V *DenseIdTable<V>::search(const int &id) const
+{
+    int32_t slot = slotFor(id);
+    return slot == NO_SLOT ? nullptr : &records[slot];
+}
+
+template <typename V>
+bool DenseIdTable<V>::update(const int &id, const V &newValue)
+{
+    V *val = search(id);
+    if (!val)
+        return false;
+    *val = newValue;
+    return true;
+}
+
+// Swap-with-last keeps the records contiguous
+template <typename V>
+bool DenseIdTable<V>::remove(const int &id)
+{
+    int32_t slot = slotFor(id);
+    if (slot == NO_SLOT)
+        return false;
+
+    setSlot(id, NO_SLOT);
+    int32_t last = (int32_t)records.size() - 1;
+    if (slot != last)
+    {
+        records[slot] = std::move(records[last]);
+        recordIds[slot] = recordIds[last];
+        setSlot(recordIds[slot], slot);
+    }
+    records.pop_back();
+    recordIds.pop_back();
+    return true;
+}
+
+template <typename V>
+int DenseIdTable<V>::bulkLoad(vector<pair<int, V>> &&entries, DuplicatePolicy policy)
+{
+    vector<int> ids;
+    ids.reserve(entries.size());
+    for (const pair<int, V> &entry : entries)
+        ids.push_back(entry.first);
+    plan(ids);
+
+    records.reserve(records.size() + entries.size());
+    recordIds.reserve(recordIds.size() + entries.size());
+
+    int added = 0;
+    for (pair<int, V> &entry : entries)
+    {
+        int32_t slot = slotFor(entry.first);
+        if (slot == NO_SLOT)
+        {
+            insert(entry.first, std::move(entry.second));
+            added++;
+        }
+        else if (policy == DuplicatePolicy::KeepLast)
+        {
+            records[slot] = std::move(entry.second);
+        }
+    }
+
+    entries.clear();
+    return added;
+}
+
+template <typename V>
+vector<pair<int, V>> DenseIdTable<V>::getAllEntries() const
+{
+    vector<pair<int, V>> entries;
+    entries.reserve(records.size());
+    for (size_t i = 0; i < records.size(); i++)
+        entries.push_back(make_pair(recordIds[i], records[i]));
+    return entries;
+}
+
+// -----------------------
+// Explicit template instantiation
+// -----------------------
+#include "../entities/header/book.h"
+
+template class DenseIdTable<Book>; // BookManager storage for dense accession numbers
+template class DenseIdTable<int>;  // tests and benchmarks
@@ -0,0 +1,244 @@
+#include "../header/EpochHashTable.h"
+#include <functional>
+
+template <typename K, typename V>
+typename EpochHashTable<K, V>::Buckets *EpochHashTable<K, V>::allocateBuckets(int capacity)
+{
+    Buckets *b = new Buckets;
+    b->capacity = capacity;
+    b->heads = new atomic<Node *>[capacity];
+    for (int i = 0; i < capacity; i++)
+        b->heads[i].store(nullptr, memory_order_relaxed);
+    return b;
+}
+
+template <typename K, typename V>
+void EpochHashTable<K, V>::deleteNode(void *node)
+{
+    delete static_cast<Node *>(node);
+}
+
+template <typename K, typename V>
+void EpochHashTable<K, V>::deleteBuckets(void *buckets)
+{
+    Buckets *b = static_cast<Buckets *>(buckets);
+    for (int i = 0; i < b->capacity; i++)
+    {
+        Node *n = b->heads[i].load(memory_order_relaxed);
+        while (n)
+        {
+            Node *next = n->next.load(memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+    deleteBucketArray(b);
+}
+
+template <typename K, typename V>
+void EpochHashTable<K, V>::deleteBucketArray(void *buckets)
+{
+    Buckets *b = static_cast<Buckets *>(buckets);
+    delete[] b->heads;
+    delete b;
+}
+
+template <typename K, typename V>
+EpochHashTable<K, V>::EpochHashTable(int initialCapacity, double maxLoadFactor)
+    : count(0), maxLoadFactor(maxLoadFactor > 0 ? maxLoadFactor : 0.75)
+{
+    int capacity = 16;
+    while (capacity < initialCapacity)
+        capacity *= 2;
+    current.store(allocateBuckets(capacity), memory_order_relaxed);
+}
+
+// No reader may be active once the table itself is being destroyed
+template <typename K, typename V>
+EpochHashTable<K, V>::~EpochHashTable()
+{
+    retired.drain();
+    deleteBuckets(current.load(memory_order_relaxed));
+}
+
+// indexFor() keeps only the low bits and std::hash for integers is the
+// identity in libstdc++, so strided IDs would share a few chains unmixed
+template <typename K, typename V>
+size_t EpochHashTable<K, V>::hashOf(const K &key)
+{
+    return MixedHash()(key);
+}
+
+// -----------READ PATH-----------
+// Acquire loads only: on x86 and ARM these compile to ordinary loads, so
+// readers never write to a shared cache line.
+template <typename K, typename V>
+typename EpochHashTable<K, V>::Node *EpochHashTable<K, V>::findNode(const K &key) const
+{
+    Buckets *b = current.load(memory_order_acquire);
+    Node *n = b->heads[indexFor(hashOf(key), b->capacity)].load(memory_order_acquire);
+    while (n)
+    {
+        if (n->key == key)
+            return n;
+        n = n->next.load(memory_order_acquire);
+    }
+    return nullptr;
+}
+
+template <typename K, typename V>
+V *EpochHashTable<K, V>::search(const K &key)
+{
+    Node *n = findNode(key);
+    return n ? &n->value : nullptr;
+}
+
+template <typename K, typename V>
+vector<pair<K, V>> EpochHashTable<K, V>::getAllEntries() const
+{
+    vector<pair<K, V>> entries;
+    entries.reserve(size());
+    forEach([&](const K &key, const V &value)
+            { entries.push_back(make_pair(key, value)); });
+    return entries;
+}
+
+// -----------WRITE PATH-----------
+// Rebuilds into a bucket array large enough for `incoming` more keys. Nodes
+// are copied rather than relinked, because readers may still be walking the
+// old chains.
+template <typename K, typename V>
+void EpochHashTable<K, V>::growIfNeeded(int incoming)
+{
+    Buckets *old = current.load(memory_order_relaxed);
+    long long expected = (long long)count.load(memory_order_relaxed) + incoming;
+    int newCapacity = old->capacity;
+    while (expected > newCapacity * maxLoadFactor)
+        newCapacity *= 2;
+    if (newCapacity == old->capacity)
+        return;
+
+    Buckets *grown = allocateBuckets(newCapacity);
+    for (int i = 0; i < old->capacity; i++)
+    {
+        for (Node *n = old->heads[i].load(memory_order_relaxed); n; n = n->next.load(memory_order_relaxed))
+        {
+            atomic<Node *> &head = grown->heads[indexFor(hashOf(n->key), grown->capacity)];
+            head.store(new Node(n->key, n->value, head.load(memory_order_relaxed)), memory_order_relaxed);
+        }
+    }
+
+    current.store(grown, memory_order_release);
+    retired.retire(old, &deleteBuckets);
+}
+
+template <typename K, typename V>
+bool EpochHashTable<K, V>::insert(const K &key, const V &value)
+{
+    lock_guard<mutex> guard(writeLock);
+    growIfNeeded();
+
+    Buckets *b = current.load(memory_order_relaxed);
+    atomic<Node *> &head = b->heads[indexFor(hashOf(key), b->capacity)];
+    head.store(new Node(key, value, head.load(memory_order_relaxed)), memory_order_release);
+    count.store(count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+
+    retired.reclaim();
+    return true;
+}
+
+template <typename K, typename V>
+int EpochHashTable<K, V>::bulkLoad(vector<pair<K, V>> &&entries, DuplicatePolicy policy)
+{
+    lock_guard<mutex> guard(writeLock);
+    growIfNeeded((int)entries.size());
+
+    Buckets *b = current.load(memory_order_relaxed);
+    int added = 0;
+    for (pair<K, V> &entry : entries)
+    {
+        atomic<Node *> &head = b->heads[indexFor(hashOf(entry.first), b->capacity)];
+        atomic<Node *> *link = &head;
+        Node *n = link->load(memory_order_relaxed);
+        while (n && !(n->key == entry.first))
+        {
+            link = &n->next;
+            n = link->load(memory_order_relaxed);
+        }
+
+        if (!n)
+        {
+            head.store(new Node(std::move(entry.first), std::move(entry.second), head.load(memory_order_relaxed)),
+                       memory_order_release);
+            added++;
+        }
+        else if (policy == DuplicatePolicy::KeepLast)
+        {
+            // Same copy-on-write swap as update()
+            link->store(new Node(std::move(entry.first), std::move(entry.second), n->next.load(memory_order_relaxed)),
+                        memory_order_release);
+            retired.retire(n, &deleteNode);
+        }
+    }
+    count.store(count.load(memory_order_relaxed) + added, memory_order_relaxed);
+
+    entries.clear();
+    retired.reclaim();
+    return added;
+}
+
+// Copy-on-write: readers see either the old node or the new one, never a
+// half-assigned value
+template <typename K, typename V>
+bool EpochHashTable<K, V>::update(const K &key, const V &newValue)
+{
+    lock_guard<mutex> guard(writeLock);
+
+    Buckets *b = current.load(memory_order_relaxed);
+    atomic<Node *> *link = &b->heads[indexFor(hashOf(key), b->capacity)];
+    for (Node *n = link->load(memory_order_relaxed); n; n = link->load(memory_order_relaxed))
+    {
+        if (n->key == key)
+        {
+            Node *replacement = new Node(key, newValue, n->next.load(memory_order_relaxed));
+            link->store(replacement, memory_order_release);
+            retired.retire(n, &deleteNode);
+            retired.reclaim();
+            return true;
+        }
+        link = &n->next;
+    }
+    return false;
+}
+
+// The unlinked node keeps its next pointer, so a reader standing on it
+// still reaches the rest of the chain
+template <typename K, typename V>
+bool EpochHashTable<K, V>::remove(const K &key)
+{
+    lock_guard<mutex> guard(writeLock);
+
+    Buckets *b = current.load(memory_order_relaxed);
+    atomic<Node *> *link = &b->heads[indexFor(hashOf(key), b->capacity)];
+    for (Node *n = link->load(memory_order_relaxed); n; n = link->load(memory_order_relaxed))
+    {
+        if (n->key == key)
+        {
+            link->store(n->next.load(memory_order_relaxed), memory_order_release);
+            count.store(count.load(memory_order_relaxed) - 1, memory_order_relaxed);
+            retired.retire(n, &deleteNode);
+            retired.reclaim();
+            return true;
+        }
+        link = &n->next;
+    }
+    return false;
+}
+
+// -----------------------
+// Explicit template instantiation
+// -----------------------
+#include "../entities/header/book.h"
+
+template class EpochHashTable<int, Book>; // kiosk-facing catalog
+template class EpochHashTable<int, int>;  // benchmarks
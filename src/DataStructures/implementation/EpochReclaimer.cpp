@@ -0,0 +1,129 @@
+#include "../header/EpochReclaimer.h"
+#include <thread>
+
+// Per-thread registration: a slot is claimed on the thread's first read
+// section and handed back when the thread exits
+struct EpochThreadState
+{
+    EpochDomain::ReaderSlot *slot = nullptr;
+    int depth = 0; // nesting level of EpochGuards
+
+    ~EpochThreadState()
+    {
+        if (slot)
+        {
+            slot->epoch.store(0, std::memory_order_release);
+            slot->claimed.store(false, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local EpochThreadState threadState;
+
+EpochDomain::EpochDomain() : globalEpoch(1)
+{
+    for (int i = 0; i < MAX_READER_THREADS; i++)
+    {
+        slots[i].epoch.store(0, std::memory_order_relaxed);
+        slots[i].claimed.store(false, std::memory_order_relaxed);
+    }
+}
+
+EpochDomain &EpochDomain::global()
+{
+    static EpochDomain domain;
+    return domain;
+}
+
+// One-time claim per thread; waits for a free slot if all are taken
+EpochDomain::ReaderSlot &EpochDomain::slotForThisThread()
+{
+    if (threadState.slot)
+        return *threadState.slot;
+
+    while (true)
+    {
+        for (int i = 0; i < MAX_READER_THREADS; i++)
+        {
+            bool expected = false;
+            if (!slots[i].claimed.load(std::memory_order_relaxed) &&
+                slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                threadState.slot = &slots[i];
+                return slots[i];
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+void EpochDomain::enter()
+{
+    if (threadState.depth++ > 0)
+        return;
+
+    ReaderSlot &slot = slotForThisThread();
+    slot.epoch.store(globalEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    // Make the announcement visible before any protected pointer is loaded
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void EpochDomain::exit()
+{
+    if (--threadState.depth > 0)
+        return;
+
+    threadState.slot->epoch.store(0, std::memory_order_release);
+}
+
+uint64_t EpochDomain::tryAdvance()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = globalEpoch.load(std::memory_order_acquire);
+
+    for (int i = 0; i < MAX_READER_THREADS; i++)
+    {
+        uint64_t seen = slots[i].epoch.load(std::memory_order_acquire);
+        if (seen != 0 && seen != epoch)
+            return epoch; // a reader is still in an older epoch
+    }
+
+    // Another writer may have advanced it meanwhile; either way it moved on
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+    return globalEpoch.load(std::memory_order_acquire);
+}
+
+// -----------------------
+// RetireList
+// -----------------------
+void RetireList::retire(void *ptr, void (*deleter)(void *))
+{
+    uint64_t epoch = EpochDomain::global().currentEpoch();
+    pending.push_back({ptr, deleter, epoch});
+}
+
+void RetireList::reclaim()
+{
+    if (pending.empty())
+        return;
+
+    uint64_t epoch = EpochDomain::global().tryAdvance();
+
+    // Readers in epoch e may still hold objects retired in e or e - 1
+    size_t kept = 0;
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        if (pending[i].epoch + 2 <= epoch)
+            pending[i].deleter(pending[i].ptr);
+        else
+            pending[kept++] = pending[i];
+    }
+    pending.resize(kept);
+}
+
+void RetireList::drain()
+{
+    for (const Retired &r : pending)
+        r.deleter(r.ptr);
+    pending.clear();
+}
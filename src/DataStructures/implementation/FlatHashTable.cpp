@@ -0,0 +1,443 @@
+#include "../header/FlatHashTable.h"
+#include <functional>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_USE_SSE2 1
+#endif
+
+// Index of the lowest set bit of a non-zero mask
+static inline int lowestBit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int i = 0;
+    while (!(mask & 1u))
+    {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// hashOf() is the Hash policy's value, the same one HashTable::hashOf returns
+// under that policy, so views and precomputed hashes line up with the stored keys.
+template <typename K, typename V, typename Hash>
+size_t FlatHashTable<K, V, Hash>::hashOf(const K &key)
+{
+    return Hash()(key);
+}
+
+template <typename K, typename V, typename Hash>
+size_t FlatHashTable<K, V, Hash>::hashOf(KeyView key)
+{
+    if constexpr (std::is_same<KeyView, NoKeyView>::value)
+        return 0;
+    else
+        return Hash()(key);
+}
+
+// StdHash for integers is the identity in libstdc++, so mix the bits
+// before splitting them into a group index (high bits) and a 7-bit tag.
+template <typename K, typename V, typename Hash>
+size_t FlatHashTable<K, V, Hash>::mix(size_t hash)
+{
+    uint64_t x = (uint64_t)hash;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+// -----------GROUP MATCHING-----------
+// Each returns a 16-bit mask with bit i set when control byte base+i matches.
+
+template <typename K, typename V, typename Hash>
+uint32_t FlatHashTable<K, V, Hash>::matchTag(int base, int8_t tag) const
+{
+#ifdef FLAT_HASH_USE_SSE2
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl + base));
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++)
+        if (ctrl[base + i] == tag)
+            mask |= 1u << i;
+    return mask;
+#endif
+}
+
+template <typename K, typename V, typename Hash>
+uint32_t FlatHashTable<K, V, Hash>::matchEmpty(int base) const
+{
+#ifdef FLAT_HASH_USE_SSE2
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl + base));
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(CTRL_EMPTY)));
+#else
+    return matchTag(base, CTRL_EMPTY);
+#endif
+}
+
+template <typename K, typename V, typename Hash>
+uint32_t FlatHashTable<K, V, Hash>::matchEmptyOrDeleted(int base) const
+{
+#ifdef FLAT_HASH_USE_SSE2
+    // EMPTY (-128) and DELETED (-2) are the only control values below -1
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl + base));
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), group));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++)
+        if (ctrl[base + i] < -1)
+            mask |= 1u << i;
+    return mask;
+#endif
+}
+
+// -----------STORAGE-----------
+
+template <typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::allocate(int newCapacity)
+{
+    capacity = newCapacity;
+    ctrl = new int8_t[capacity];
+    memset(ctrl, CTRL_EMPTY, capacity);
+    slots = static_cast<Slot *>(::operator new(sizeof(Slot) * capacity));
+    tombstones = 0;
+}
+
+template <typename K, typename V, typename Hash>
+FlatHashTable<K, V, Hash>::FlatHashTable(int initialCapacity) : ctrl(nullptr), slots(nullptr), capacity(0), count(0), tombstones(0)
+{
+    int cap = GROUP_WIDTH;
+    while (cap < initialCapacity)
+        cap *= 2;
+    allocate(cap);
+}
+
+template <typename K, typename V, typename Hash>
+FlatHashTable<K, V, Hash>::~FlatHashTable()
+{
+    for (int i = 0; i < capacity; i++)
+        if (isFull(ctrl[i]))
+            slots[i].~Slot();
+    delete[] ctrl;
+    ::operator delete(slots);
+}
+
+// -----------PROBING-----------
+// Triangular probing over groups visits every group exactly once when the
+// group count is a power of two. A probe stops at the first group that
+// still has an EMPTY byte: no key was ever pushed past such a group.
+
+template <typename K, typename V, typename Hash>
+template <typename Q>
+int FlatHashTable<K, V, Hash>::findIndex(const Q &key, size_t hash) const
+{
+    if constexpr (std::is_same<Q, NoKeyView>::value)
+        return -1;
+
+    int8_t tag = tagOf(hash);
+    int mask = groupCount() - 1;
+    int group = firstGroup(hash);
+
+    for (int step = 0; step <= mask; step++)
+    {
+        int base = group * GROUP_WIDTH;
+        uint32_t candidates = matchTag(base, tag);
+        while (candidates)
+        {
+            int i = base + lowestBit(candidates);
+            if constexpr (!std::is_same<Q, NoKeyView>::value)
+                if (slots[i].key == key)
+                    return i;
+            candidates &= candidates - 1;
+        }
+        if (matchEmpty(base))
+            return -1;
+        group = (group + step + 1) & mask;
+    }
+    return -1;
+}
+
+template <typename K, typename V, typename Hash>
+int FlatHashTable<K, V, Hash>::findInsertSlot(size_t hash) const
+{
+    int mask = groupCount() - 1;
+    int group = firstGroup(hash);
+
+    for (int step = 0; step <= mask; step++)
+    {
+        int base = group * GROUP_WIDTH;
+        uint32_t free = matchEmptyOrDeleted(base);
+        if (free)
+            return base + lowestBit(free);
+        group = (group + step + 1) & mask;
+    }
+    return -1; // unreachable: reserveOne() keeps the table below 7/8 full
+}
+
+// -----------GROWTH-----------
+
+template <typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::resize(int newCapacity)
+{
+    int8_t *oldCtrl = ctrl;
+    Slot *oldSlots = slots;
+    int oldCapacity = capacity;
+
+    allocate(newCapacity);
+
+    for (int i = 0; i < oldCapacity; i++)
+    {
+        if (!isFull(oldCtrl[i]))
+            continue;
+        size_t hash = hashKey(oldSlots[i].key);
+        int target = findInsertSlot(hash);
+        new (&slots[target]) Slot{std::move(oldSlots[i].key), std::move(oldSlots[i].value)};
+        ctrl[target] = tagOf(hash);
+        oldSlots[i].~Slot();
+    }
+
+    delete[] oldCtrl;
+    ::operator delete(oldSlots);
+}
+
+// Clears tombstones without allocating. Every full slot is first marked
+// DELETED ("still to place") and every tombstone EMPTY; each marked slot
+// then either stays in its probe group, moves into an EMPTY slot, or swaps
+// with another still-to-place slot which is processed next.
+template <typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::rehashInPlace()
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        if (isFull(ctrl[i]))
+            ctrl[i] = CTRL_DELETED;
+        else
+            ctrl[i] = CTRL_EMPTY;
+    }
+    tombstones = 0;
+
+    for (int i = 0; i < capacity; i++)
+    {
+        if (ctrl[i] != CTRL_DELETED)
+            continue;
+
+        size_t hash = hashKey(slots[i].key);
+        int target = findInsertSlot(hash);
+
+        if (target / GROUP_WIDTH == i / GROUP_WIDTH)
+        {
+            ctrl[i] = tagOf(hash);
+        }
+        else if (ctrl[target] == CTRL_EMPTY)
+        {
+            new (&slots[target]) Slot{std::move(slots[i].key), std::move(slots[i].value)};
+            slots[i].~Slot();
+            ctrl[target] = tagOf(hash);
+            ctrl[i] = CTRL_EMPTY;
+        }
+        else
+        {
+            std::swap(slots[i], slots[target]);
+            ctrl[target] = tagOf(hash);
+            i--; // place the element that was swapped into i
+        }
+    }
+}
+
+// Ensures there is room for one more element, keeping full + deleted slots at or below 7/8
+template <typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::reserveOne()
+{
+    if ((long long)(count + tombstones + 1) * 8 <= (long long)capacity * 7)
+        return;
+
+    // Mostly tombstones: reclaim them in place instead of growing
+    if (tombstones > 0 && (long long)(count + 1) * 16 <= (long long)capacity * 7)
+        rehashInPlace();
+    else
+        resize(capacity * 2);
+}
+
+// -----------PUBLIC API-----------
+
+template <typename K, typename V, typename Hash>
+int FlatHashTable<K, V, Hash>::claimSlot(size_t hash)
+{
+    reserveOne();
+
+    size_t mixed = mix(hash);
+    int target = findInsertSlot(mixed);
+    if (ctrl[target] == CTRL_DELETED)
+        tombstones--;
+
+    ctrl[target] = tagOf(mixed);
+    count++;
+    return target;
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::insert(const K &key, const V &value)
+{
+    return emplace(key, value);
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::insert(const K &key, V &&value)
+{
+    return emplace(key, std::move(value));
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::insert(K &&key, V &&value)
+{
+    return emplace(std::move(key), std::move(value));
+}
+
+template <typename K, typename V, typename Hash>
+int FlatHashTable<K, V, Hash>::bulkLoad(vector<pair<K, V>> &&entries, DuplicatePolicy policy)
+{
+    // Worst case (no duplicates) must stay within the 7/8 load limit
+    long long expected = (long long)count + (long long)entries.size();
+    int newCapacity = capacity;
+    while (expected * 8 > (long long)newCapacity * 7)
+        newCapacity *= 2;
+    if (newCapacity != capacity)
+        resize(newCapacity);
+
+    int added = 0;
+    for (pair<K, V> &entry : entries)
+    {
+        pair<V *, bool> result = try_emplace(std::move(entry.first), std::move(entry.second));
+        if (result.second)
+            added++;
+        else if (policy == DuplicatePolicy::KeepLast)
+            *result.first = std::move(entry.second);
+    }
+
+    entries.clear();
+    return added;
+}
+
+template <typename K, typename V, typename Hash>
+V *FlatHashTable<K, V, Hash>::search(const K &key)
+{
+    int index = findIndex(key);
+    return index >= 0 ? &slots[index].value : nullptr;
+}
+
+template <typename K, typename V, typename Hash>
+V *FlatHashTable<K, V, Hash>::search(KeyView key)
+{
+    return search(key, hashOf(key));
+}
+
+template <typename K, typename V, typename Hash>
+V *FlatHashTable<K, V, Hash>::search(const K &key, size_t hash)
+{
+    int index = findIndex(key, mix(hash));
+    return index >= 0 ? &slots[index].value : nullptr;
+}
+
+template <typename K, typename V, typename Hash>
+V *FlatHashTable<K, V, Hash>::search(KeyView key, size_t hash)
+{
+    int index = findIndex(key, mix(hash));
+    return index >= 0 ? &slots[index].value : nullptr;
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::update(const K &key, const V &newValue)
+{
+    V *val = search(key);
+    if (!val)
+        return false;
+    *val = newValue;
+    return true;
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::update(const K &key, V &&newValue)
+{
+    V *val = search(key);
+    if (!val)
+        return false;
+    *val = std::move(newValue);
+    return true;
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::remove(const K &key)
+{
+    int index = findIndex(key);
+    if (index < 0)
+        return false;
+    eraseAt(index);
+    return true;
+}
+
+template <typename K, typename V, typename Hash>
+bool FlatHashTable<K, V, Hash>::remove(KeyView key)
+{
+    int index = findIndex(key, mix(hashOf(key)));
+    if (index < 0)
+        return false;
+    eraseAt(index);
+    return true;
+}
+
+template <typename K, typename V, typename Hash>
+void FlatHashTable<K, V, Hash>::eraseAt(int index)
+{
+    slots[index].~Slot();
+    count--;
+
+    // A group that still has an EMPTY byte never made a probe continue past it,
+    // so the slot can go straight back to EMPTY; otherwise leave a tombstone.
+    int base = index - index % GROUP_WIDTH;
+    if (matchEmpty(base))
+    {
+        ctrl[index] = CTRL_EMPTY;
+    }
+    else
+    {
+        ctrl[index] = CTRL_DELETED;
+        tombstones++;
+    }
+}
+
+template <typename K, typename V, typename Hash>
+vector<pair<K, V>> FlatHashTable<K, V, Hash>::getAllEntries() const
+{
+    vector<pair<K, V>> entries;
+    entries.reserve(count);
+    for (int i = 0; i < capacity; i++)
+        if (isFull(ctrl[i]))
+            entries.push_back(make_pair(slots[i].key, slots[i].value));
+    return entries;
+}
+
+// -----------------------
+// Explicit template instantiation
+// -----------------------
+#include "../entities/header/book.h"
+#include "../header/linkedList.h"
+#include "../header/LoanList.h"
+
+template class FlatHashTable<int, Book>;                       // BookManager storage
+template class FlatHashTable<string, LinkedList<std::string>>; // name/title keyed lists
+template class FlatHashTable<string, LoanList>;                // Borrower loan lists
+template class FlatHashTable<string, Loan *>;                  // Borrower loan index
+template class FlatHashTable<string, int>;                     // Borrower borrow counts
+template class FlatHashTable<int, int>;                        // benchmarks
+template class FlatHashTable<int, int, MixedHash>;             // precomputed hashes shared with HashTable
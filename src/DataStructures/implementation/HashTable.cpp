@@ -1,66 +1,344 @@
 #include "../header/HashTable.h"
 #include <functional>
-
-// HashNode constructor
-template <typename K, typename V>
-HashNode<K, V>::HashNode(K k, V v) : key(k), value(v), next(nullptr) {}
+#include <new>
+#include <type_traits>
 
 // HashTable implementations
-template <typename K, typename V>
-HashTable<K, V>::HashTable()
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+HashTable<K, V, Alloc, Hash, Reduce>::HashTable(int initialCapacity, double maxLoadFactor)
+    : table(nullptr), capacity(Reduce::roundCapacity(initialCapacity > 0 ? initialCapacity : DEFAULT_CAPACITY)),
+      oldTable(nullptr), oldCapacity(0), rehashIndex(0), count(0),
+      maxLoadFactor(maxLoadFactor > 0 ? maxLoadFactor : 0.75),
+      bloom(nullptr), bloomTarget(0.01), bloomSkipped(0)
 {
-    for (int i = 0; i < TABLE_SIZE; i++)
+    table = new HashNode<K, V> *[capacity];
+    for (int i = 0; i < capacity; i++)
         table[i] = nullptr;
 }
 
-template <typename K, typename V>
-HashTable<K, V>::~HashTable()
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+HashTable<K, V, Alloc, Hash, Reduce>::~HashTable()
 {
-    for (int i = 0; i < TABLE_SIZE; i++)
+    HashNode<K, V> **arrays[2] = {table, oldTable};
+    int sizes[2] = {capacity, oldCapacity};
+
+    // A bulk-releasing allocator frees whole slabs below, so nodes only need
+    // their destructors run (and not even that for trivial key/value types)
+    bool perNodeWork = !Alloc::RELEASES_IN_BULK || !std::is_trivially_destructible<HashNode<K, V>>::value;
+
+    for (int a = 0; a < 2; a++)
     {
-        HashNode<K, V> *entry = table[i];
+        if (!arrays[a])
+            continue;
+        for (int i = 0; perNodeWork && i < sizes[a]; i++)
+        {
+            HashNode<K, V> *entry = arrays[a][i];
+            while (entry)
+            {
+                HashNode<K, V> *prev = entry;
+                entry = entry->next;
+                if (Alloc::RELEASES_IN_BULK)
+                    prev->~HashNode<K, V>();
+                else
+                    destroyNode(prev);
+            }
+        }
+        delete[] arrays[a];
+    }
+
+    nodeAllocator.releaseAll();
+    delete bloom;
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::destroyNode(HashNode<K, V> *node)
+{
+    node->~HashNode<K, V>();
+    nodeAllocator.deallocate(node, sizeof(HashNode<K, V>));
+}
+
+// The hash policy is transparent and std::hash<std::string> agrees with
+// std::hash<std::string_view>, so a view probes the same bucket as the
+// stored string.
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename Q>
+size_t HashTable<K, V, Alloc, Hash, Reduce>::hashKey(const Q &key)
+{
+    if constexpr (std::is_same<Q, NoKeyView>::value)
+        return 0;
+    else
+        return Hash()(key);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+size_t HashTable<K, V, Alloc, Hash, Reduce>::hashOf(const K &key)
+{
+    return hashKey(key);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+size_t HashTable<K, V, Alloc, Hash, Reduce>::hashOf(KeyView key)
+{
+    return hashKey(key);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+int HashTable<K, V, Alloc, Hash, Reduce>::hashFunction(const K &key, int buckets) const
+{
+    return bucketFor(hashKey(key), buckets);
+}
+
+// -----------INCREMENTAL REHASHING-----------
+// Allocates the new bucket array and keeps the current one as oldTable.
+// Buckets are then moved over a few at a time by rehashStep().
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::startRehash(int newCapacity)
+{
+    // Only one rehash can be in flight at a time
+    finishRehash();
+
+    oldTable = table;
+    oldCapacity = capacity;
+    rehashIndex = 0;
+
+    capacity = newCapacity;
+    table = new HashNode<K, V> *[capacity];
+    for (int i = 0; i < capacity; i++)
+        table[i] = nullptr;
+}
+
+// Moves up to REHASH_STEP old buckets into the active array.
+// Nodes are relinked rather than copied, so pointers returned by search() stay valid.
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::rehashStep()
+{
+    if (!oldTable)
+        return;
+
+    int moved = 0;
+    while (rehashIndex < oldCapacity && moved < REHASH_STEP)
+    {
+        HashNode<K, V> *entry = oldTable[rehashIndex];
         while (entry)
         {
-            HashNode<K, V> *prev = entry;
+            HashNode<K, V> *next = entry->next;
+            int index = hashFunction(entry->key, capacity);
+            entry->next = table[index];
+            table[index] = entry;
+            entry = next;
+        }
+        oldTable[rehashIndex] = nullptr;
+        rehashIndex++;
+        moved++;
+    }
+
+    if (rehashIndex >= oldCapacity)
+    {
+        delete[] oldTable;
+        oldTable = nullptr;
+        oldCapacity = 0;
+        rehashIndex = 0;
+    }
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::finishRehash()
+{
+    while (oldTable)
+        rehashStep();
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::checkGrow()
+{
+    // Grow even while a rehash is in flight: startRehash() drains the pending
+    // one first, so a small maxLoadFactor cannot push the load past its bound.
+    // Keep doubling in case setMaxLoadFactor() just lowered the limit a lot.
+    if (count <= capacity * maxLoadFactor)
+        return;
+    int newCapacity = capacity * 2;
+    while (count > newCapacity * maxLoadFactor)
+        newCapacity *= 2;
+    startRehash(newCapacity);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::checkShrink()
+{
+    // Shrink only when well under the limit so alternating insert/remove does not thrash
+    if (!oldTable && capacity > DEFAULT_CAPACITY && count < capacity * maxLoadFactor / 4)
+        startRehash(capacity / 2);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::setMaxLoadFactor(double factor)
+{
+    if (factor <= 0)
+        return;
+    maxLoadFactor = factor;
+    checkGrow();
+}
+
+// Looks the key up in the active array and, during a rehash, in the
+// part of the old array that has not been migrated yet.
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename Q>
+HashNode<K, V> *HashTable<K, V, Alloc, Hash, Reduce>::findNode(const Q &key, size_t hash) const
+{
+    if constexpr (std::is_same<Q, NoKeyView>::value)
+    {
+        return nullptr;
+    }
+    else
+    {
+        if (bloom && !bloom->mightContain(hash))
+        {
+            bloomSkipped.fetch_add(1, memory_order_relaxed);
+            return nullptr;
+        }
+
+        HashNode<K, V> *entry = table[bucketFor(hash, capacity)];
+        while (entry)
+        {
+            if (entry->key == key)
+                return entry;
             entry = entry->next;
-            delete prev;
         }
+
+        if (oldTable)
+        {
+            int index = bucketFor(hash, oldCapacity);
+            if (index >= rehashIndex)
+            {
+                entry = oldTable[index];
+                while (entry)
+                {
+                    if (entry->key == key)
+                        return entry;
+                    entry = entry->next;
+                }
+            }
+        }
+        return nullptr;
     }
 }
 
-template <typename K, typename V>
-int HashTable<K, V>::hashFunction(const K &key)
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::linkNode(HashNode<K, V> *node, size_t hash)
 {
-    std::hash<K> hasher;
-    return hasher(key) % TABLE_SIZE;
+    int index = bucketFor(hash, capacity);
+    node->next = table[index];
+    table[index] = node;
+    count++;
+
+    if (bloom)
+    {
+        bloom->add(hash);
+        if (bloom->needsRebuild())
+            rebuildBloomFilter((size_t)count * 2);
+    }
+
+    checkGrow();
 }
 
-template <typename K, typename V>
-bool HashTable<K, V>::insert(const K &key, const V &value)
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::insert(const K &key, const V &value)
 {
-    int index = hashFunction(key);
-    HashNode<K, V> *newNode = new HashNode<K, V>(key, value);
-    newNode->next = table[index];
-    table[index] = newNode;
-    return true;
+    return emplace(key, value);
 }
 
-template <typename K, typename V>
-V *HashTable<K, V>::search(const K &key)
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::insert(const K &key, V &&value)
 {
-    int index = hashFunction(key);
-    HashNode<K, V> *entry = table[index];
-    while (entry)
+    return emplace(key, std::move(value));
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::insert(K &&key, V &&value)
+{
+    return emplace(std::move(key), std::move(value));
+}
+
+// -----------BULK LOAD-----------
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+int HashTable<K, V, Alloc, Hash, Reduce>::bulkLoad(vector<pair<K, V>> &&entries, DuplicatePolicy policy)
+{
+    // Size for the worst case (no duplicates) so no insert below triggers a rehash
+    long long expected = (long long)count + (long long)entries.size();
+    int newCapacity = capacity;
+    while (expected > newCapacity * maxLoadFactor)
+        newCapacity *= 2;
+
+    if (newCapacity != capacity)
+        startRehash(newCapacity);
+    finishRehash();
+
+    nodeAllocator.reserve(sizeof(HashNode<K, V>), entries.size());
+
+    // Size the filter for the whole batch up front instead of rebuilding it
+    // every time the count doubles
+    if (bloom && (size_t)expected > bloom->designedCapacity())
+        rebuildBloomFilter((size_t)expected);
+
+    int added = 0;
+    for (pair<K, V> &entry : entries)
     {
-        if (entry->key == key)
-            return &entry->value;
-        entry = entry->next;
+        pair<V *, bool> result = try_emplace(std::move(entry.first), std::move(entry.second));
+        if (result.second)
+            added++;
+        else if (policy == DuplicatePolicy::KeepLast)
+            *result.first = std::move(entry.second);
     }
-    return nullptr;
+
+    entries.clear();
+    return added;
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+V *HashTable<K, V, Alloc, Hash, Reduce>::search(const K &key)
+{
+    return search(key, hashKey(key));
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+V *HashTable<K, V, Alloc, Hash, Reduce>::search(KeyView key)
+{
+    return search(key, hashKey(key));
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+V *HashTable<K, V, Alloc, Hash, Reduce>::search(const K &key, size_t hash)
+{
+    rehashStep();
+
+    HashNode<K, V> *entry = findNode(key, hash);
+    return entry ? &entry->value : nullptr;
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+V *HashTable<K, V, Alloc, Hash, Reduce>::search(KeyView key, size_t hash)
+{
+    rehashStep();
+
+    HashNode<K, V> *entry = findNode(key, hash);
+    return entry ? &entry->value : nullptr;
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+const V *HashTable<K, V, Alloc, Hash, Reduce>::search(const K &key) const
+{
+    return search(key, hashKey(key));
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+const V *HashTable<K, V, Alloc, Hash, Reduce>::search(const K &key, size_t hash) const
+{
+    HashNode<K, V> *entry = findNode(key, hash);
+    return entry ? &entry->value : nullptr;
 }
 
-template <typename K, typename V>
-bool HashTable<K, V>::update(const K &key, const V &newValue)
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::update(const K &key, const V &newValue)
 {
     V *val = search(key);
     if (!val)
@@ -69,36 +347,98 @@ bool HashTable<K, V>::update(const K &key, const V &newValue)
     return true;
 }
 
-template <typename K, typename V>
-bool HashTable<K, V>::remove(const K &key)
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::update(const K &key, V &&newValue)
+{
+    V *val = search(key);
+    if (!val)
+        return false;
+    *val = std::move(newValue);
+    return true;
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::remove(const K &key)
+{
+    return removeNode(key, hashKey(key));
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+bool HashTable<K, V, Alloc, Hash, Reduce>::remove(KeyView key)
 {
-    int index = hashFunction(key);
-    HashNode<K, V> *entry = table[index];
-    HashNode<K, V> *prev = nullptr;
+    return removeNode(key, hashKey(key));
+}
 
-    while (entry)
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+template <typename Q>
+bool HashTable<K, V, Alloc, Hash, Reduce>::removeNode(const Q &key, size_t hash)
+{
+    if constexpr (std::is_same<Q, NoKeyView>::value)
+    {
+        return false;
+    }
+    else
     {
-        if (entry->key == key)
+        rehashStep();
+
+        if (bloom && !bloom->mightContain(hash))
         {
-            if (prev)
-                prev->next = entry->next;
-            else
-                table[index] = entry->next;
+            bloomSkipped.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+
+        HashNode<K, V> **buckets[2] = {table, oldTable};
+        int sizes[2] = {capacity, oldCapacity};
 
-            delete entry;
-            return true;
+        for (int a = 0; a < 2; a++)
+        {
+            if (!buckets[a])
+                continue;
+
+            int index = bucketFor(hash, sizes[a]);
+            if (a == 1 && index < rehashIndex)
+                continue; // already migrated
+
+            HashNode<K, V> *entry = buckets[a][index];
+            HashNode<K, V> *prev = nullptr;
+
+            while (entry)
+            {
+                if (entry->key == key)
+                {
+                    if (prev)
+                        prev->next = entry->next;
+                    else
+                        buckets[a][index] = entry->next;
+
+                    destroyNode(entry);
+                    count--;
+
+                    if (bloom)
+                    {
+                        bloom->noteRemoval();
+                        if (bloom->needsRebuild())
+                            rebuildBloomFilter((size_t)count * 2);
+                    }
+
+                    checkShrink();
+                    return true;
+                }
+                prev = entry;
+                entry = entry->next;
+            }
         }
-        prev = entry;
-        entry = entry->next;
+        return false;
     }
-    return false;
 }
 
-template <typename K, typename V>
-vector<pair<K, V>> HashTable<K, V>::getAllEntries() const
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+vector<pair<K, V>> HashTable<K, V, Alloc, Hash, Reduce>::getAllEntries() const
 {
     vector<pair<K, V>> entries;
-    for (int i = 0; i < TABLE_SIZE; i++)
+    entries.reserve(count);
+
+    for (int i = 0; i < capacity; i++)
     {
         HashNode<K, V> *entry = table[i];
         while (entry)
@@ -107,16 +447,122 @@ vector<pair<K, V>> HashTable<K, V>::getAllEntries() const
             entry = entry->next;
         }
     }
+
+    // Buckets not yet migrated by an in-progress rehash
+    for (int i = rehashIndex; oldTable && i < oldCapacity; i++)
+    {
+        HashNode<K, V> *entry = oldTable[i];
+        while (entry)
+        {
+            entries.push_back(make_pair(entry->key, entry->value));
+            entry = entry->next;
+        }
+    }
     return entries;
 }
 
+// -----------DISTRIBUTION STATS-----------
+// One read-only pass over both bucket arrays; buckets still waiting in an
+// in-progress rehash count as buckets of their own.
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+HashTableStats HashTable<K, V, Alloc, Hash, Reduce>::stats() const
+{
+    HashTableStats s;
+    s.size = count;
+    s.buckets = capacity;
+    s.loadFactor = loadFactor();
+    s.emptyBuckets = 0;
+    s.maxChain = 0;
+    s.meanChain = 0.0;
+    s.p99Chain = 0;
+
+    auto countChain = [&](const HashNode<K, V> *entry)
+    {
+        int length = 0;
+        for (; entry; entry = entry->next)
+            length++;
+        if ((int)s.histogram.size() <= length)
+            s.histogram.resize(length + 1, 0);
+        s.histogram[length]++;
+        if (length == 0)
+            s.emptyBuckets++;
+        if (length > s.maxChain)
+            s.maxChain = length;
+    };
+
+    for (int i = 0; i < capacity; i++)
+        countChain(table[i]);
+    for (int i = rehashIndex; oldTable && i < oldCapacity; i++)
+        countChain(oldTable[i]);
+
+    // Mean and p99 are taken over non-empty buckets, i.e. the chains a lookup can actually walk
+    long long nonEmpty = 0;
+    for (size_t len = 1; len < s.histogram.size(); len++)
+        nonEmpty += s.histogram[len];
+
+    if (nonEmpty > 0)
+    {
+        s.meanChain = (double)count / nonEmpty;
+
+        long long threshold = (nonEmpty * 99 + 99) / 100; // ceil(0.99 * nonEmpty)
+        long long seen = 0;
+        for (size_t len = 1; len < s.histogram.size(); len++)
+        {
+            seen += s.histogram[len];
+            if (seen >= threshold)
+            {
+                s.p99Chain = (int)len;
+                break;
+            }
+        }
+    }
+    return s;
+}
+
+// -----------BLOOM FILTER-----------
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::enableBloomFilter(double falsePositiveRate)
+{
+    bloomTarget = falsePositiveRate;
+    rebuildBloomFilter((size_t)count * 2);
+}
+
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::disableBloomFilter()
+{
+    delete bloom;
+    bloom = nullptr;
+}
+
+// O(n), but only after the count doubles or half the filtered keys are
+// gone, so amortized O(1) per insert/remove
+template <typename K, typename V, typename Alloc, typename Hash, typename Reduce>
+void HashTable<K, V, Alloc, Hash, Reduce>::rebuildBloomFilter(size_t expectedKeys)
+{
+    delete bloom;
+    bloom = new BlockedBloomFilter(expectedKeys + DEFAULT_CAPACITY, bloomTarget);
+    forEach([&](const K &key, const V &)
+            { bloom->add(hashKey(key)); });
+}
+
 // -----------------------
 // Explicit template instantiation
 // -----------------------
 #include "../entities/header/book.h"
 #include "../header/linkedList.h"
+#include "../header/LoanList.h"
 
 template class HashTable<int, Book>;                       // for your BookManager usage
 template class HashTable<string, string>;                  // if you need string/string hash table
 template class HashTable<int, LinkedList<std::string>>;    // for Borrower module
-template class HashTable<string, LinkedList<std::string>>; // name/title based Borrower
+template class HashTable<string, LinkedList<std::string>>; // name/title keyed lists
+template class HashTable<string, LoanList>;                // Borrower loan lists
+template class HashTable<string, Loan *>;                  // Borrower loan index
+template class HashTable<string, int>;                     // Borrower borrow counts
+template class HashTable<string_view, int>;                // HistoryLog string pools
+template class HashTable<int, vector<int>>;                // TrigramIndex posting lists
+template class HashTable<int, int>;                        // lightweight payload for scaling benchmarks
+template class HashTable<int, int, HeapAllocator>;         // allocator comparison benchmark
+template class HashTable<int, int, SlabAllocator, StdHash, MaskReduction>;        // hash policy
+template class HashTable<int, int, SlabAllocator, MixedHash, MaskReduction>;      // comparison
+template class HashTable<int, int, SlabAllocator, MixedHash, FastRangeReduction>; // benchmark
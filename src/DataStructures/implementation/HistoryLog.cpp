@@ -0,0 +1,90 @@
+#include "../header/HistoryLog.h"
+
+string HistoryLog::Entry::toLine() const
+{
+    if (note)
+        return string(title);
+
+    string line;
+    line.reserve(user.size() + title.size() + date.size() + action.size() + 3);
+    line.append(user).append(1, ',').append(title).append(1, ',').append(date).append(1, ',').append(action);
+    return line;
+}
+
+uint32_t HistoryLog::StringPool::intern(string_view text)
+{
+    if (const int *id = ids.search(text))
+        return (uint32_t)*id;
+
+    strings.emplace_back(text);
+    uint32_t id = (uint32_t)(strings.size() - 1);
+    ids.insert(string_view(strings.back()), (int)id); // the view points at the pooled copy
+    return id;
+}
+
+HistoryLog::HistoryLog() : count(0) {}
+
+HistoryLog::~HistoryLog()
+{
+    for (Event *chunk : chunks)
+        delete[] chunk;
+}
+
+HistoryLog::Event &HistoryLog::push()
+{
+    if (count == chunks.size() * CHUNK_EVENTS)
+        chunks.push_back(new Event[CHUNK_EVENTS]);
+
+    Event &event = chunks[count / CHUNK_EVENTS][count % CHUNK_EVENTS];
+    count++;
+    return event;
+}
+
+void HistoryLog::append(string_view user, string_view title, string_view date, string_view action)
+{
+    // Past the packed ID ranges (16M distinct dates, 256 actions) the event
+    // is kept whole as a note, so nothing is lost
+    if ((dates.size() >= MAX_DATES && !dates.ids.search(date)) ||
+        (actions.size() >= MAX_ACTIONS && !actions.ids.search(action)))
+    {
+        Entry entry = {user, title, date, action, false};
+        appendNote(entry.toLine());
+        return;
+    }
+
+    uint32_t userId = names.intern(user);
+    uint32_t titleId = names.intern(title);
+    uint32_t dateId = dates.intern(date);
+    uint32_t actionId = actions.intern(action);
+
+    Event &event = push();
+    event.user = userId;
+    event.title = titleId;
+    event.dateAndAction = dateId << 8 | actionId;
+}
+
+void HistoryLog::appendNote(string_view text)
+{
+    uint32_t textId = names.intern(text);
+
+    Event &event = push();
+    event.user = NOTE_USER;
+    event.title = textId;
+    event.dateAndAction = 0;
+}
+
+HistoryLog::Entry HistoryLog::operator[](size_t index) const
+{
+    const Event &event = chunks[index / CHUNK_EVENTS][index % CHUNK_EVENTS];
+
+    Entry entry;
+    entry.note = event.user == NOTE_USER;
+    entry.title = names.at(event.title);
+    if (!entry.note)
+    {
+        entry.user = names.at(event.user);
+        entry.date = dates.at(event.dateAndAction >> 8);
+        entry.action = actions.at(event.dateAndAction & (MAX_ACTIONS - 1));
+    }
+    return entry;
+}
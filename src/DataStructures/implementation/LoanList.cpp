@@ -0,0 +1,31 @@
+#include "../header/LoanList.h"
+
+void LoanList::pushBack(Loan *loan)
+{
+    loan->prev[side] = tail;
+    loan->next[side] = nullptr;
+    if (tail)
+        tail->next[side] = loan;
+    else
+        head = loan;
+
+    tail = loan;
+    count++;
+}
+
+void LoanList::unlink(Loan *loan)
+{
+    if (loan->prev[side])
+        loan->prev[side]->next[side] = loan->next[side];
+    else
+        head = loan->next[side];
+
+    if (loan->next[side])
+        loan->next[side]->prev[side] = loan->prev[side];
+    else
+        tail = loan->prev[side];
+
+    loan->prev[side] = nullptr;
+    loan->next[side] = nullptr;
+    count--;
+}
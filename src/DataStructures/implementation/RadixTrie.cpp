@@ -0,0 +1,834 @@
+#include "../header/RadixTrie.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <new>
+#include <queue>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RADIX_TRIE_USE_SSE2 1
+#endif
+
+// Index of the lowest set bit of a non-zero mask
+static inline int lowestBit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int i = 0;
+    while (!(mask & 1u))
+    {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Child slots per node kind, indexed by RadixNodeType
+static const int NODE_CAPACITY[] = {0, 4, 16, 48, 256};
+
+// Calls visit(byte, child) for every child in ascending byte order
+template <typename Visitor>
+static void forEachChild(const RadixNode *node, Visitor visit)
+{
+    switch (node->type)
+    {
+    case RADIX_NODE4:
+    {
+        const RadixNode4 *n = static_cast<const RadixNode4 *>(node);
+        for (int i = 0; i < n->childCount; i++)
+            visit(n->keys[i], n->children[i]);
+        break;
+    }
+    case RADIX_NODE16:
+    {
+        const RadixNode16 *n = static_cast<const RadixNode16 *>(node);
+        for (int i = 0; i < n->childCount; i++)
+            visit(n->keys[i], n->children[i]);
+        break;
+    }
+    case RADIX_NODE48:
+    {
+        const RadixNode48 *n = static_cast<const RadixNode48 *>(node);
+        for (int b = 0; b < 256; b++)
+            if (n->childIndex[b])
+                visit((uint8_t)b, n->children[n->childIndex[b] - 1]);
+        break;
+    }
+    case RADIX_NODE256:
+    {
+        const RadixNode256 *n = static_cast<const RadixNode256 *>(node);
+        for (int b = 0; b < 256; b++)
+            if (n->children[b])
+                visit((uint8_t)b, n->children[b]);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+int RadixTrie::keyByte(char c)
+{
+    unsigned char byte = (unsigned char)c;
+    if (byte >= 128)
+        return -1;
+    return tolower(byte);
+}
+
+// -----------NODES-----------
+
+RadixNode *RadixTrie::newNode(RadixNodeType type, uint32_t labelOffset, uint32_t labelLength)
+{
+    RadixNode *node;
+    switch (type)
+    {
+    case RADIX_NODE4:
+        node = new (nodeAllocator.allocate(sizeof(RadixNode4))) RadixNode4();
+        nodeBytes += sizeof(RadixNode4);
+        break;
+    case RADIX_NODE16:
+        node = new (nodeAllocator.allocate(sizeof(RadixNode16))) RadixNode16();
+        nodeBytes += sizeof(RadixNode16);
+        break;
+    case RADIX_NODE48:
+        node = new (nodeAllocator.allocate(sizeof(RadixNode48))) RadixNode48();
+        nodeBytes += sizeof(RadixNode48);
+        break;
+    case RADIX_NODE256:
+        node = new (nodeAllocator.allocate(sizeof(RadixNode256))) RadixNode256();
+        nodeBytes += sizeof(RadixNode256);
+        break;
+    default:
+        node = new (nodeAllocator.allocate(sizeof(RadixNode))) RadixNode();
+        nodeBytes += sizeof(RadixNode);
+        break;
+    }
+
+    node->type = type;
+    node->labelOffset = labelOffset;
+    node->labelLength = labelLength;
+    return node;
+}
+
+// Node kinds are trivially destructible; the block goes back to its size class
+void RadixTrie::freeNode(RadixNode *node)
+{
+    size_t size;
+    switch (node->type)
+    {
+    case RADIX_NODE4:
+        size = sizeof(RadixNode4);
+        break;
+    case RADIX_NODE16:
+        size = sizeof(RadixNode16);
+        break;
+    case RADIX_NODE48:
+        size = sizeof(RadixNode48);
+        break;
+    case RADIX_NODE256:
+        size = sizeof(RadixNode256);
+        break;
+    default:
+        size = sizeof(RadixNode);
+        break;
+    }
+    nodeBytes -= size;
+    nodeAllocator.deallocate(node, size);
+}
+
+RadixNode *RadixTrie::newLeaf(const string &key, size_t from)
+{
+    uint32_t offset = (uint32_t)labels.size();
+    labels.insert(labels.end(), key.begin() + from, key.end());
+
+    RadixNode *leaf = newNode(RADIX_LEAF, offset, (uint32_t)(key.size() - from));
+    leaf->isEnd = true;
+    leaf->count = 1;
+    return leaf;
+}
+
+// -----------CHILDREN-----------
+
+RadixNode **RadixTrie::findChild(RadixNode *node, uint8_t byte)
+{
+    switch (node->type)
+    {
+    case RADIX_NODE4:
+    {
+        RadixNode4 *n = static_cast<RadixNode4 *>(node);
+        for (int i = 0; i < n->childCount; i++)
+            if (n->keys[i] == byte)
+                return &n->children[i];
+        return nullptr;
+    }
+    case RADIX_NODE16:
+    {
+        RadixNode16 *n = static_cast<RadixNode16 *>(node);
+#ifdef RADIX_TRIE_USE_SSE2
+        __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(keys, _mm_set1_epi8((char)byte)));
+        mask &= (1u << n->childCount) - 1;
+        return mask ? &n->children[lowestBit(mask)] : nullptr;
+#else
+        for (int i = 0; i < n->childCount; i++)
+            if (n->keys[i] == byte)
+                return &n->children[i];
+        return nullptr;
+#endif
+    }
+    case RADIX_NODE48:
+    {
+        RadixNode48 *n = static_cast<RadixNode48 *>(node);
+        return n->childIndex[byte] ? &n->children[n->childIndex[byte] - 1] : nullptr;
+    }
+    case RADIX_NODE256:
+    {
+        RadixNode256 *n = static_cast<RadixNode256 *>(node);
+        return n->children[byte] ? &n->children[byte] : nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+// Sorted insert into the key/child arrays of a Node4 or Node16
+template <typename SortedNode>
+static void insertSorted(SortedNode *n, uint8_t byte, RadixNode *child)
+{
+    int i = n->childCount;
+    while (i > 0 && n->keys[i - 1] > byte)
+    {
+        n->keys[i] = n->keys[i - 1];
+        n->children[i] = n->children[i - 1];
+        i--;
+    }
+    n->keys[i] = byte;
+    n->children[i] = child;
+}
+
+void RadixTrie::addChild(RadixNode **slot, uint8_t byte, RadixNode *child)
+{
+    if ((*slot)->childCount == NODE_CAPACITY[(*slot)->type])
+        grow(slot);
+
+    RadixNode *node = *slot;
+    switch (node->type)
+    {
+    case RADIX_NODE4:
+        insertSorted(static_cast<RadixNode4 *>(node), byte, child);
+        break;
+    case RADIX_NODE16:
+        insertSorted(static_cast<RadixNode16 *>(node), byte, child);
+        break;
+    case RADIX_NODE48:
+    {
+        RadixNode48 *n = static_cast<RadixNode48 *>(node);
+        n->children[n->childCount] = child;
+        n->childIndex[byte] = (uint8_t)(n->childCount + 1);
+        break;
+    }
+    case RADIX_NODE256:
+        static_cast<RadixNode256 *>(node)->children[byte] = child;
+        break;
+    default:
+        break;
+    }
+    node->childCount++;
+}
+
+// Removes byte from the sorted key/child arrays of a Node4 or Node16
+template <typename SortedNode>
+static void removeSorted(SortedNode *n, uint8_t byte)
+{
+    int i = 0;
+    while (n->keys[i] != byte)
+        i++;
+    for (; i + 1 < n->childCount; i++)
+    {
+        n->keys[i] = n->keys[i + 1];
+        n->children[i] = n->children[i + 1];
+    }
+}
+
+void RadixTrie::removeChild(RadixNode *node, uint8_t byte)
+{
+    switch (node->type)
+    {
+    case RADIX_NODE4:
+        removeSorted(static_cast<RadixNode4 *>(node), byte);
+        break;
+    case RADIX_NODE16:
+        removeSorted(static_cast<RadixNode16 *>(node), byte);
+        break;
+    case RADIX_NODE48:
+    {
+        // The last slot moves into the freed one
+        RadixNode48 *n = static_cast<RadixNode48 *>(node);
+        int slot = n->childIndex[byte] - 1;
+        int last = n->childCount - 1;
+        n->childIndex[byte] = 0;
+        if (slot != last)
+        {
+            for (int b = 0; b < 256; b++)
+                if (n->childIndex[b] == last + 1)
+                {
+                    n->childIndex[b] = (uint8_t)(slot + 1);
+                    break;
+                }
+            n->children[slot] = n->children[last];
+        }
+        n->children[last] = nullptr;
+        break;
+    }
+    case RADIX_NODE256:
+        static_cast<RadixNode256 *>(node)->children[byte] = nullptr;
+        break;
+    default:
+        return;
+    }
+    node->childCount--;
+}
+
+// Replaces *slot with the next node kind up, moving its children across
+void RadixTrie::grow(RadixNode **slot)
+{
+    RadixNode *node = *slot;
+    RadixNodeType biggerType = (RadixNodeType)(node->type + 1);
+    RadixNode *bigger = newNode(biggerType, node->labelOffset, node->labelLength);
+    *bigger = *node; // header: label, end flag, weights, child count
+    bigger->type = biggerType;
+
+    switch (node->type)
+    {
+    case RADIX_NODE4:
+    {
+        RadixNode4 *from = static_cast<RadixNode4 *>(node);
+        RadixNode16 *to = static_cast<RadixNode16 *>(bigger);
+        memcpy(to->keys, from->keys, sizeof(from->keys));
+        memcpy(to->children, from->children, sizeof(from->children));
+        break;
+    }
+    case RADIX_NODE16:
+    {
+        RadixNode16 *from = static_cast<RadixNode16 *>(node);
+        RadixNode48 *to = static_cast<RadixNode48 *>(bigger);
+        for (int i = 0; i < from->childCount; i++)
+        {
+            to->childIndex[from->keys[i]] = (uint8_t)(i + 1);
+            to->children[i] = from->children[i];
+        }
+        break;
+    }
+    case RADIX_NODE48:
+    {
+        RadixNode48 *from = static_cast<RadixNode48 *>(node);
+        RadixNode256 *to = static_cast<RadixNode256 *>(bigger);
+        for (int b = 0; b < 256; b++)
+            if (from->childIndex[b])
+                to->children[b] = from->children[from->childIndex[b] - 1];
+        break;
+    }
+    default:
+        break; // a leaf has no children to move
+    }
+
+    freeNode(node);
+    *slot = bigger;
+}
+
+// -----------TRIE-----------
+
+RadixTrie::RadixTrie() : keyCount(0), nodeBytes(0)
+{
+    root = newNode(RADIX_LEAF, 0, 0);
+}
+
+RadixTrie::~RadixTrie()
+{
+    nodeAllocator.releaseAll();
+}
+
+void RadixTrie::insert(const string &word)
+{
+    // Same key as Trie: lowercase ASCII, other bytes skipped
+    string key;
+    key.reserve(word.size());
+    for (char c : word)
+    {
+        int byte = keyByte(c);
+        if (byte >= 0)
+            key.push_back((char)byte);
+    }
+
+    RadixNode **slot = &root;
+    size_t depth = 0;
+    while (true)
+    {
+        RadixNode *node = *slot;
+        const char *label = labels.data() + node->labelOffset;
+        uint32_t match = 0;
+        while (match < node->labelLength && depth + match < key.size() && label[match] == key[depth + match])
+            match++;
+
+        if (match < node->labelLength)
+        {
+            // The key leaves the label part way: a new node takes the shared
+            // part and node keeps what follows the byte they differ on
+            uint8_t nodeByte = (uint8_t)label[match];
+            RadixNode *upper = newNode(RADIX_NODE4, node->labelOffset, match);
+            upper->maxWeight = node->maxWeight; // a new key has weight 0
+            node->labelOffset += match + 1;
+            node->labelLength -= match + 1;
+            addChild(&upper, nodeByte, node);
+
+            if (depth + match == key.size())
+            {
+                upper->isEnd = true;
+                upper->count = 1;
+            }
+            else
+                addChild(&upper, (uint8_t)key[depth + match], newLeaf(key, depth + match + 1));
+
+            *slot = upper;
+            keyCount++;
+            return;
+        }
+
+        depth += match;
+        if (depth == key.size())
+        {
+            if (!node->isEnd)
+            {
+                node->isEnd = true;
+                keyCount++;
+            }
+            node->count++;
+            return;
+        }
+
+        uint8_t byte = (uint8_t)key[depth];
+        RadixNode **child = findChild(node, byte);
+        if (!child)
+        {
+            addChild(slot, byte, newLeaf(key, depth + 1));
+            keyCount++;
+            return;
+        }
+
+        slot = child;
+        depth++;
+    }
+}
+
+void RadixTrie::collect(const RadixNode *node, string &path, vector<string> &results) const
+{
+    if (node->isEnd)
+        results.push_back(path);
+
+    size_t base = path.size();
+    forEachChild(node, [&](uint8_t byte, const RadixNode *child)
+                 {
+                     path.push_back((char)byte);
+                     path.append(labels.data() + child->labelOffset, child->labelLength);
+                     collect(child, path, results);
+                     path.resize(base); });
+}
+
+const RadixNode *RadixTrie::findPrefix(const string &prefix, string &path) const
+{
+    path = prefix;
+    const RadixNode *node = root;
+    size_t depth = 0;
+    while (true)
+    {
+        const char *label = labels.data() + node->labelOffset;
+        for (uint32_t i = 0; i < node->labelLength; i++)
+        {
+            if (depth == prefix.size())
+            {
+                // The prefix ends inside this label; the rest of it is common to every completion
+                path.append(label + i, node->labelLength - i);
+                return node;
+            }
+            if (keyByte(prefix[depth]) != (uint8_t)label[i])
+                return nullptr;
+            depth++;
+        }
+
+        if (depth == prefix.size())
+            return node;
+
+        int byte = keyByte(prefix[depth]);
+        if (byte < 0)
+            return nullptr;
+
+        RadixNode **child = findChild(const_cast<RadixNode *>(node), (uint8_t)byte);
+        if (!child)
+            return nullptr;
+        node = *child;
+        depth++;
+    }
+}
+
+RadixNode *RadixTrie::findKey(const string &word, vector<RadixNode *> *ancestors)
+{
+    string key;
+    key.reserve(word.size());
+    for (char c : word)
+    {
+        int byte = keyByte(c);
+        if (byte >= 0)
+            key.push_back((char)byte);
+    }
+
+    RadixNode *node = root;
+    size_t depth = 0;
+    while (true)
+    {
+        if (node->labelLength > key.size() - depth ||
+            key.compare(depth, node->labelLength, labels.data() + node->labelOffset, node->labelLength) != 0)
+            return nullptr;
+        depth += node->labelLength;
+
+        if (depth == key.size())
+            return node->isEnd ? node : nullptr;
+
+        RadixNode **child = findChild(node, (uint8_t)key[depth]);
+        if (!child)
+            return nullptr;
+        if (ancestors)
+            ancestors->push_back(node);
+        node = *child;
+        depth++;
+    }
+}
+
+bool RadixTrie::remove(const string &word)
+{
+    vector<RadixNode *> ancestors;
+    RadixNode *node = findKey(word, &ancestors);
+    if (!node)
+        return false;
+    if (--node->count > 0)
+        return true;
+
+    node->isEnd = false;
+    node->weight = 0;
+    keyCount--;
+    if (node->postings)
+    {
+        postingLists[node->postings - 1].clear();
+        freePostings.push_back(node->postings - 1);
+        node->postings = 0;
+    }
+
+    // Free the key's node, and each parent it leaves empty, bottom up.
+    // The byte a node hangs from is the one just before its label.
+    string key;
+    key.reserve(word.size());
+    for (char c : word)
+    {
+        int byte = keyByte(c);
+        if (byte >= 0)
+            key.push_back((char)byte);
+    }
+    size_t keyEnd = key.size(); // key length down to the end of ancestors.back()
+
+    ancestors.push_back(node);
+    while (ancestors.size() > 1)
+    {
+        RadixNode *current = ancestors.back();
+        if (current->isEnd || current->childCount > 0)
+            break;
+        keyEnd -= current->labelLength;
+        ancestors.pop_back();
+        removeChild(ancestors.back(), (uint8_t)key[--keyEnd]);
+        freeNode(current);
+    }
+
+    // Subtree maxima along what is left of the path
+    for (size_t i = ancestors.size(); i > 0; i--)
+        refreshMaxWeight(ancestors[i - 1]);
+    return true;
+}
+
+int RadixTrie::count(const string &word) const
+{
+    const RadixNode *node = const_cast<RadixTrie *>(this)->findKey(word, nullptr);
+    return node ? (int)node->count : 0;
+}
+
+void RadixTrie::insert(const string &word, int id)
+{
+    insert(word);
+    RadixNode *node = findKey(word, nullptr);
+    if (!node->postings)
+    {
+        if (freePostings.empty())
+        {
+            postingLists.emplace_back();
+            node->postings = (uint32_t)postingLists.size();
+        }
+        else
+        {
+            node->postings = freePostings.back() + 1;
+            freePostings.pop_back();
+        }
+    }
+    postingLists[node->postings - 1].push_back(id);
+}
+
+bool RadixTrie::remove(const string &word, int id)
+{
+    RadixNode *node = findKey(word, nullptr);
+    if (!node || !node->postings)
+        return false;
+
+    vector<int> &ids = postingLists[node->postings - 1];
+    vector<int>::iterator found = std::find(ids.begin(), ids.end(), id);
+    if (found == ids.end())
+        return false;
+    *found = ids.back();
+    ids.pop_back();
+    return remove(word);
+}
+
+vector<int> RadixTrie::idsOf(const string &word) const
+{
+    const RadixNode *node = const_cast<RadixTrie *>(this)->findKey(word, nullptr);
+    if (!node || !node->postings)
+        return vector<int>();
+    return postingLists[node->postings - 1];
+}
+
+// Results keep the prefix as typed, followed by the stored lowercase rest,
+// in the same order as Trie::getAutoComplete
+vector<string> RadixTrie::getAutoComplete(const string &prefix) const
+{
+    vector<string> results;
+    string path;
+    if (const RadixNode *node = findPrefix(prefix, path))
+        collect(node, path, results);
+    return results;
+}
+
+// -----------RANKING-----------
+
+void RadixTrie::refreshMaxWeight(RadixNode *node)
+{
+    uint32_t best = node->isEnd ? node->weight : 0;
+    forEachChild(node, [&](uint8_t, const RadixNode *child)
+                 { best = max(best, child->maxWeight); });
+    node->maxWeight = best;
+}
+
+bool RadixTrie::setWeight(const string &word, uint32_t weight)
+{
+    vector<RadixNode *> ancestors;
+    RadixNode *node = findKey(word, &ancestors);
+    if (!node)
+        return false;
+
+    node->weight = weight;
+
+    // Recompute the subtree maxima from the key up to the root
+    ancestors.push_back(node);
+    for (size_t i = ancestors.size(); i > 0; i--)
+        refreshMaxWeight(ancestors[i - 1]);
+    return true;
+}
+
+uint32_t RadixTrie::weightOf(const string &word) const
+{
+    const RadixNode *node = const_cast<RadixTrie *>(this)->findKey(word, nullptr);
+    return node ? node->weight : 0;
+}
+
+// Best-first search: the queue holds subtrees ranked by their maximum
+// weight and keys ranked by their own, so a key leaves the queue only once
+// nothing left can beat it. Equal weights go in title order: every key in
+// a subtree spells at least the subtree's path, and a node's own key comes
+// before the keys below it, so the k kept are the k smallest titles among
+// any tie. Without weights this is a depth-first walk in byte order.
+void RadixTrie::bestFirst(const vector<pair<const RadixNode *, string>> &roots, int k, vector<pair<uint32_t, string>> &out) const
+{
+    struct Record
+    {
+        const RadixNode *node;
+        string path; // through the node's label
+    };
+    struct Entry
+    {
+        uint32_t weight;
+        int record;
+        bool isKey; // the record's own key, not its subtree
+    };
+
+    vector<Record> records;
+    auto lower = [&records](const Entry &a, const Entry &b)
+    {
+        if (a.weight != b.weight)
+            return a.weight < b.weight;
+        int order = records[a.record].path.compare(records[b.record].path);
+        return order != 0 ? order > 0 : a.isKey < b.isKey;
+    };
+    priority_queue<Entry, vector<Entry>, decltype(lower)> queue(lower);
+    for (const pair<const RadixNode *, string> &root : roots)
+    {
+        records.push_back(Record{root.first, root.second});
+        queue.push(Entry{root.first->maxWeight, (int)records.size() - 1, false});
+    }
+
+    string path;
+    int found = 0;
+    while (!queue.empty() && found < k)
+    {
+        Entry entry = queue.top();
+        queue.pop();
+
+        if (entry.isKey)
+        {
+            out.emplace_back(entry.weight, records[entry.record].path);
+            found++;
+            continue;
+        }
+
+        const RadixNode *node = records[entry.record].node;
+        path = records[entry.record].path; // records may grow below
+        forEachChild(node, [&](uint8_t byte, const RadixNode *child)
+                     {
+                         string childPath = path;
+                         childPath.push_back((char)byte);
+                         childPath.append(labels.data() + child->labelOffset, child->labelLength);
+                         records.push_back(Record{child, std::move(childPath)});
+                         queue.push(Entry{child->maxWeight, (int)records.size() - 1, false}); });
+        if (node->isEnd)
+            queue.push(Entry{node->weight, entry.record, true});
+    }
+}
+
+vector<string> RadixTrie::getAutoComplete(const string &prefix, int k) const
+{
+    vector<string> results;
+    string base;
+    const RadixNode *start = k > 0 ? findPrefix(prefix, base) : nullptr;
+    if (!start)
+        return results;
+
+    vector<pair<uint32_t, string>> ranked;
+    bestFirst({{start, base}}, k, ranked);
+    for (pair<uint32_t, string> &entry : ranked)
+        results.push_back(std::move(entry.second));
+    return results;
+}
+
+// -----------FUZZY-----------
+
+// The Levenshtein walk of StaticTrie::getFuzzyAutoComplete, one row per key
+// byte: the byte a child hangs from and each byte of its label. A subtree
+// is cut or taken whole as soon as some byte settles it; keys sit at the
+// end of a label.
+vector<string> RadixTrie::getFuzzyAutoComplete(const string &prefix, int maxEdits, int k) const
+{
+    vector<string> results;
+    if (k <= 0 || maxEdits < 0)
+        return results;
+
+    string query;
+    for (char c : prefix)
+    {
+        int byte = keyByte(c);
+        if (byte >= 0)
+            query.push_back((char)byte);
+    }
+    size_t width = query.size() + 1;
+
+    vector<vector<pair<const RadixNode *, string>>> subtrees(maxEdits + 1);
+    vector<vector<pair<uint32_t, string>>> keys(maxEdits + 1);
+
+    struct Frame
+    {
+        const RadixNode *node;
+        uint32_t depth; // key bytes before the node's branch byte
+        int best;       // smallest prefix distance on the path above
+        int byte;       // branch byte, or -1 for the root
+    };
+    vector<uint16_t> rows(width);
+    for (size_t j = 0; j < width; j++)
+        rows[j] = (uint16_t)j;
+    vector<Frame> stack(1, Frame{root, 0, (int)width, -1});
+    vector<Frame> children;
+    string path;
+
+    while (!stack.empty())
+    {
+        Frame frame = stack.back();
+        stack.pop_back();
+
+        path.resize(frame.depth);
+        if (frame.byte >= 0)
+            path.push_back((char)frame.byte);
+        path.append(labels.data() + frame.node->labelOffset, frame.node->labelLength);
+
+        // One row per byte this node adds; rows[d] belongs to path[0..d)
+        size_t depth = frame.depth;
+        if (rows.size() < (path.size() + 1) * width)
+            rows.resize((path.size() + 1) * width);
+        int best = frame.best;
+        int rowMin = 0;
+        bool settled = false;
+        // The root's row is the initial one; other nodes start below their parent's last row
+        if (frame.byte >= 0)
+            depth++;
+        for (; depth <= path.size() && !settled; depth++)
+        {
+            uint16_t *row = rows.data() + depth * width;
+            if (depth > 0)
+            {
+                const uint16_t *above = row - width;
+                row[0] = (uint16_t)(above[0] + 1);
+                for (size_t j = 1; j < width; j++)
+                {
+                    uint16_t substitute = (uint16_t)(above[j - 1] + (query[j - 1] != path[depth - 1]));
+                    row[j] = min(substitute, (uint16_t)(min(above[j], row[j - 1]) + 1));
+                }
+            }
+            rowMin = *min_element(row, row + width);
+            best = min(best, (int)row[width - 1]);
+            // Every key below has distance best, or none can get within maxEdits
+            settled = (best <= maxEdits && rowMin >= best) || rowMin > maxEdits;
+        }
+        if (settled)
+        {
+            if (best <= maxEdits)
+                subtrees[best].emplace_back(frame.node, path);
+            continue;
+        }
+
+        if (best <= maxEdits && frame.node->isEnd)
+            keys[best].emplace_back(frame.node->weight, path);
+
+        children.clear();
+        forEachChild(frame.node, [&](uint8_t byte, const RadixNode *child)
+                     { children.push_back(Frame{child, (uint32_t)path.size(), best, byte}); });
+        for (size_t i = children.size(); i > 0; i--)
+            stack.push_back(children[i - 1]);
+    }
+
+    vector<pair<uint32_t, string>> level;
+    for (int distance = 0; distance <= maxEdits && (int)results.size() < k; distance++)
+    {
+        int wanted = k - (int)results.size();
+        level.clear();
+        bestFirst(subtrees[distance], wanted, level);
+        level.insert(level.end(), keys[distance].begin(), keys[distance].end());
+        sort(level.begin(), level.end(), [](const pair<uint32_t, string> &a, const pair<uint32_t, string> &b)
+             { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+        for (int i = 0; i < (int)level.size() && i < wanted; i++)
+            results.push_back(std::move(level[i].second));
+    }
+    return results;
+}
@@ -0,0 +1,186 @@
+#include "../header/SlabAllocator.h"
+#include <new>
+
+SlabAllocator::SlabAllocator() : classes(nullptr), slabs(nullptr), large(nullptr) {}
+
+SlabAllocator::~SlabAllocator()
+{
+    releaseAll();
+}
+
+SlabAllocator::SlabAllocator(SlabAllocator &&other) noexcept
+    : classes(other.classes), slabs(other.slabs), large(other.large)
+{
+    other.classes = nullptr;
+    other.slabs = nullptr;
+    other.large = nullptr;
+}
+
+SlabAllocator &SlabAllocator::operator=(SlabAllocator &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+    releaseAll();
+    classes = other.classes;
+    slabs = other.slabs;
+    large = other.large;
+    other.classes = nullptr;
+    other.slabs = nullptr;
+    other.large = nullptr;
+    return *this;
+}
+
+static size_t roundToClass(size_t size, size_t alignment)
+{
+    if (size < sizeof(void *))
+        size = sizeof(void *);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Finds (or creates) the size class serving blocks of blockSize bytes
+SlabAllocator::SizeClass *SlabAllocator::classFor(size_t blockSize)
+{
+    for (SizeClass *sc = classes; sc; sc = sc->next)
+        if (sc->blockSize == blockSize)
+            return sc;
+
+    SizeClass *sc = new SizeClass;
+    sc->blockSize = blockSize;
+    sc->freeList = nullptr;
+    sc->bumpPtr = nullptr;
+    sc->bumpEnd = nullptr;
+    sc->nextSlabBlocks = FIRST_SLAB_BLOCKS;
+    sc->next = classes;
+    classes = sc;
+    return sc;
+}
+
+// Allocates a new slab of `blocks` blocks for the class; they are handed
+// out by bumping a pointer
+void SlabAllocator::addSlab(SizeClass *sc, size_t blocks)
+{
+    size_t header = roundToClass(sizeof(Slab), ALIGNMENT);
+    size_t bytes = header + sc->blockSize * blocks;
+
+    char *raw = static_cast<char *>(::operator new(bytes));
+    Slab *slab = reinterpret_cast<Slab *>(raw);
+    slab->next = slabs;
+    slabs = slab;
+
+    sc->bumpPtr = raw + header;
+    sc->bumpEnd = raw + bytes;
+}
+
+void *SlabAllocator::allocate(size_t size)
+{
+    size_t blockSize = roundToClass(size, ALIGNMENT);
+    if (blockSize > MAX_CLASS_SIZE)
+    {
+        size_t header = roundToClass(sizeof(LargeBlock), ALIGNMENT);
+        char *raw = static_cast<char *>(::operator new(header + size));
+        LargeBlock *lb = reinterpret_cast<LargeBlock *>(raw);
+        lb->prev = nullptr;
+        lb->next = large;
+        if (large)
+            large->prev = lb;
+        large = lb;
+        return raw + header;
+    }
+
+    SizeClass *sc = classFor(blockSize);
+
+    // Recycle a freed block first
+    if (sc->freeList)
+    {
+        FreeBlock *block = sc->freeList;
+        sc->freeList = block->next;
+        return block;
+    }
+
+    if (sc->bumpPtr == sc->bumpEnd)
+    {
+        addSlab(sc, sc->nextSlabBlocks);
+        if (sc->nextSlabBlocks < MAX_SLAB_BLOCKS)
+            sc->nextSlabBlocks *= 2;
+    }
+
+    void *block = sc->bumpPtr;
+    sc->bumpPtr += blockSize;
+    return block;
+}
+
+void SlabAllocator::deallocate(void *ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t blockSize = roundToClass(size, ALIGNMENT);
+    if (blockSize > MAX_CLASS_SIZE)
+    {
+        size_t header = roundToClass(sizeof(LargeBlock), ALIGNMENT);
+        LargeBlock *lb = reinterpret_cast<LargeBlock *>(static_cast<char *>(ptr) - header);
+        if (lb->prev)
+            lb->prev->next = lb->next;
+        else
+            large = lb->next;
+        if (lb->next)
+            lb->next->prev = lb->prev;
+        ::operator delete(lb);
+        return;
+    }
+
+    SizeClass *sc = classFor(blockSize);
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = sc->freeList;
+    sc->freeList = block;
+}
+
+void SlabAllocator::reserve(size_t size, size_t blocks)
+{
+    size_t blockSize = roundToClass(size, ALIGNMENT);
+    if (blockSize > MAX_CLASS_SIZE || blocks == 0)
+        return;
+
+    SizeClass *sc = classFor(blockSize);
+
+    size_t available = (sc->bumpEnd - sc->bumpPtr) / blockSize;
+    for (FreeBlock *block = sc->freeList; block && available < blocks; block = block->next)
+        available++;
+    if (available >= blocks)
+        return;
+
+    // Keep the unused tail of the current slab by moving it onto the free list
+    while (sc->bumpPtr != sc->bumpEnd)
+    {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(sc->bumpPtr);
+        block->next = sc->freeList;
+        sc->freeList = block;
+        sc->bumpPtr += blockSize;
+    }
+
+    addSlab(sc, blocks - available);
+}
+
+void SlabAllocator::releaseAll()
+{
+    while (large)
+    {
+        LargeBlock *next = large->next;
+        ::operator delete(large);
+        large = next;
+    }
+
+    while (slabs)
+    {
+        Slab *next = slabs->next;
+        ::operator delete(slabs);
+        slabs = next;
+    }
+
+    while (classes)
+    {
+        SizeClass *next = classes->next;
+        delete classes;
+        classes = next;
+    }
+}
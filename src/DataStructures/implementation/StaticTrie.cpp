@@ -0,0 +1,675 @@
+#include "../header/StaticTrie.h"
+#include <algorithm>
+#include <cctype>
+#include <queue>
+#include <utility>
+
+static inline int popCount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word; word &= word - 1)
+        count++;
+    return count;
+#endif
+}
+
+// Index of the lowest set bit of a non-zero word
+static inline int lowestBit64(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int i = 0;
+    while (!(word & 1))
+    {
+        word >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Same key bytes as Trie: lowercase ASCII, -1 for anything else
+static int keyByte(char c)
+{
+    unsigned char byte = (unsigned char)c;
+    if (byte >= 128)
+        return -1;
+    return tolower(byte);
+}
+
+StaticTrie::StaticTrie() : bitCount(0), keyCount(0), terminalCount(0)
+{
+    build(vector<string>());
+}
+
+void StaticTrie::appendBit(bool one)
+{
+    if (bitCount % 64 == 0)
+        louds.push_back(0);
+
+    if (one)
+        louds.back() |= 1ULL << (bitCount % 64);
+    bitCount++;
+}
+
+// -----------BUILD-----------
+// Breadth-first over the sorted keys, one level at a time: a node is the
+// range of keys sharing its path, and its children split that range by the
+// next byte. Only two levels of ranges are alive at once.
+void StaticTrie::build(const vector<string> &words, const vector<uint32_t> &weights, const vector<int> &ids)
+{
+    // Normalised keys, sorted, each once with its highest weight, its
+    // number of occurrences and where its IDs start
+    struct Entry
+    {
+        string key;
+        uint32_t weight;
+        int id;
+    };
+    vector<Entry> entries;
+    entries.reserve(words.size());
+    bool weighted = false;
+    bool withIds = !ids.empty();
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        string key;
+        key.reserve(words[i].size());
+        for (char c : words[i])
+        {
+            int byte = keyByte(c);
+            if (byte >= 0)
+                key.push_back((char)byte);
+        }
+        uint32_t weight = i < weights.size() ? weights[i] : 0;
+        weighted = weighted || weight > 0;
+        entries.push_back(Entry{std::move(key), weight, i < ids.size() ? ids[i] : 0});
+    }
+    sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+         { return a.key != b.key ? a.key < b.key : a.weight > b.weight; });
+
+    vector<string> keys;
+    vector<uint32_t> sortedWeights;
+    vector<uint32_t> counts;
+    vector<int> sortedIds;       // every entry's ID, grouped by key
+    vector<uint32_t> firstIds;   // per key: where its IDs start in sortedIds
+    bool repeated = false;
+    keys.reserve(entries.size());
+    for (Entry &entry : entries)
+    {
+        if (withIds)
+            sortedIds.push_back(entry.id);
+        if (!keys.empty() && keys.back() == entry.key)
+        {
+            counts.back()++;
+            repeated = true;
+            continue;
+        }
+        keys.push_back(std::move(entry.key));
+        sortedWeights.push_back(entry.weight);
+        counts.push_back(1);
+        if (withIds)
+            firstIds.push_back((uint32_t)sortedIds.size() - 1);
+    }
+    entries.clear();
+    entries.shrink_to_fit();
+
+    louds.clear();
+    zeroSamples.clear();
+    labels.clear();
+    terminal.clear();
+    terminalRank.clear();
+    keyWeights.clear();
+    subtreeMax.clear();
+    keyCounts.clear();
+    postingStart.clear();
+    postings.clear();
+    bitCount = 0;
+    keyCount = terminalCount = (int)keys.size();
+    vector<uint32_t> parents; // only for a weighted build
+
+    struct Range
+    {
+        uint32_t lo, hi;
+    };
+
+    vector<Range> level(1, Range{0, (uint32_t)keys.size()});
+    vector<Range> nextLevel;
+    labels.push_back(0); // root
+    size_t zeros = 0;
+    uint32_t node = 0;
+
+    for (size_t depth = 0; !level.empty(); depth++)
+    {
+        nextLevel.clear();
+        for (const Range &range : level)
+        {
+            uint32_t lo = range.lo;
+            if (node % 64 == 0)
+                terminal.push_back(0);
+            if (lo < range.hi && keys[lo].size() == depth)
+            {
+                terminal.back() |= 1ULL << (node % 64);
+                if (weighted)
+                    keyWeights.push_back(sortedWeights[lo]);
+                if (repeated)
+                    keyCounts.push_back(counts[lo]);
+                if (withIds)
+                {
+                    postingStart.push_back((uint32_t)postings.size());
+                    postings.insert(postings.end(), sortedIds.begin() + firstIds[lo], sortedIds.begin() + firstIds[lo] + counts[lo]);
+                }
+                lo++; // sorted, so the key that ends here comes first
+            }
+
+            while (lo < range.hi)
+            {
+                char byte = keys[lo][depth];
+                uint32_t end = lo;
+                while (end < range.hi && keys[end][depth] == byte)
+                    end++;
+                nextLevel.push_back(Range{lo, end});
+                labels.push_back((uint8_t)byte);
+                if (weighted)
+                    parents.push_back(node);
+                appendBit(true);
+                lo = end;
+            }
+
+            if (zeros % ZERO_SAMPLE == 0)
+                zeroSamples.push_back((uint32_t)bitCount);
+            appendBit(false);
+            zeros++;
+            node++;
+        }
+        level.swap(nextLevel);
+    }
+
+    if (withIds)
+        postingStart.push_back((uint32_t)postings.size());
+
+    uint32_t rank = 0;
+    for (uint64_t word : terminal)
+    {
+        terminalRank.push_back(rank);
+        rank += (uint32_t)popCount(word);
+    }
+
+    // Children are numbered after their parents, so one backward pass
+    // settles every subtree maximum
+    if (weighted)
+    {
+        subtreeMax.assign(labels.size(), 0);
+        for (uint32_t x = (uint32_t)labels.size(); x-- > 0;)
+        {
+            subtreeMax[x] = max(subtreeMax[x], ownWeight(x));
+            if (x > 0)
+                subtreeMax[parents[x - 1]] = max(subtreeMax[parents[x - 1]], subtreeMax[x]);
+        }
+    }
+
+    louds.shrink_to_fit();
+    zeroSamples.shrink_to_fit();
+    labels.shrink_to_fit();
+    terminal.shrink_to_fit();
+    keyWeights.shrink_to_fit();
+    keyCounts.shrink_to_fit();
+    postingStart.shrink_to_fit();
+    postings.shrink_to_fit();
+}
+
+size_t StaticTrie::memoryBytes() const
+{
+    return louds.capacity() * sizeof(uint64_t) + zeroSamples.capacity() * sizeof(uint32_t) +
+           labels.capacity() + terminal.capacity() * sizeof(uint64_t) + terminalRank.capacity() * sizeof(uint32_t) +
+           keyWeights.capacity() * sizeof(uint32_t) + subtreeMax.capacity() * sizeof(uint32_t) +
+           keyCounts.capacity() * sizeof(uint32_t) + postingStart.capacity() * sizeof(uint32_t) +
+           postings.capacity() * sizeof(int);
+}
+
+// -----------NAVIGATION-----------
+
+size_t StaticTrie::select0(size_t k) const
+{
+    size_t pos = zeroSamples[k / ZERO_SAMPLE];
+    size_t remaining = k % ZERO_SAMPLE; // zeros to pass after the sampled one
+    size_t w = pos / 64;
+    uint64_t zeroBits = ~louds[w] & (~0ULL << (pos % 64));
+
+    while (true)
+    {
+        size_t inWord = (size_t)popCount(zeroBits);
+        if (remaining < inWord)
+        {
+            for (; remaining; remaining--)
+                zeroBits &= zeroBits - 1;
+            return w * 64 + lowestBit64(zeroBits);
+        }
+        remaining -= inWord;
+        zeroBits = ~louds[++w];
+    }
+}
+
+size_t StaticTrie::nextZero(size_t pos) const
+{
+    size_t w = pos / 64;
+    uint64_t zeroBits = ~louds[w] & (~0ULL << (pos % 64));
+    while (!zeroBits)
+        zeroBits = ~louds[++w];
+    return w * 64 + lowestBit64(zeroBits);
+}
+
+// Node x's degree bits start right after the x-th 0 (the previous node's
+// close). Every 1 before them names one of nodes 1.., and there are
+// start - x of those, so the first child is node start - x + 1.
+void StaticTrie::children(uint32_t node, uint32_t &first, uint32_t &count) const
+{
+    size_t start = node == 0 ? 0 : select0(node - 1) + 1;
+    first = (uint32_t)(start - node + 1);
+    count = (uint32_t)(nextZero(start) - start);
+}
+
+uint32_t StaticTrie::findChild(uint32_t node, uint8_t byte) const
+{
+    uint32_t first, count;
+    children(node, first, count);
+
+    // Sibling labels are sorted and adjacent in one array
+    const uint8_t *begin = labels.data() + first;
+    const uint8_t *found = lower_bound(begin, begin + count, byte);
+    if (found == begin + count || *found != byte)
+        return 0;
+    return first + (uint32_t)(found - begin);
+}
+
+// Depth-first over an explicit stack, children pushed in reverse so they
+// pop in byte order; path is cut back to each node's depth as it pops
+void StaticTrie::collect(uint32_t start, string &path, vector<string> &results) const
+{
+    struct Frame
+    {
+        uint32_t node;
+        uint32_t parentLength;
+    };
+
+    size_t base = path.size();
+    vector<Frame> stack(1, Frame{start, (uint32_t)base});
+    while (!stack.empty())
+    {
+        Frame frame = stack.back();
+        stack.pop_back();
+
+        path.resize(frame.parentLength);
+        if (frame.node != start)
+            path.push_back((char)labels[frame.node]);
+
+        if (isLive(frame.node))
+            results.push_back(path);
+
+        uint32_t first, count;
+        children(frame.node, first, count);
+        for (uint32_t i = count; i > 0; i--)
+            stack.push_back(Frame{first + i - 1, (uint32_t)path.size()});
+    }
+    path.resize(base);
+}
+
+long long StaticTrie::findPrefix(const string &prefix) const
+{
+    uint32_t node = 0;
+    for (char c : prefix)
+    {
+        int byte = keyByte(c);
+        if (byte < 0)
+            return -1;
+        node = findChild(node, (uint8_t)byte);
+        if (!node)
+            return -1;
+    }
+    return node;
+}
+
+long long StaticTrie::findKey(const string &word, vector<uint32_t> *ancestors) const
+{
+    uint32_t node = 0;
+    for (char c : word)
+    {
+        int byte = keyByte(c);
+        if (byte < 0)
+            continue; // skipped when the key was stored, too
+        if (ancestors)
+            ancestors->push_back(node);
+        node = findChild(node, (uint8_t)byte);
+        if (!node)
+            return -1;
+    }
+    return isTerminal(node) ? (long long)node : -1;
+}
+
+// Results keep the prefix as typed, followed by the stored lowercase rest
+vector<string> StaticTrie::getAutoComplete(const string &prefix) const
+{
+    vector<string> results;
+    long long node = findPrefix(prefix);
+    if (node < 0)
+        return results;
+
+    string path = prefix;
+    collect((uint32_t)node, path, results);
+    return results;
+}
+
+// -----------UPDATES-----------
+
+bool StaticTrie::addRef(const string &word)
+{
+    long long node = findKey(word, nullptr);
+    if (node < 0)
+        return false;
+
+    if (keyCounts.empty())
+        keyCounts.assign(terminalCount, 1);
+    if (keyCounts[keyIndex((uint32_t)node)]++ == 0)
+        keyCount++;
+    return true;
+}
+
+bool StaticTrie::remove(const string &word)
+{
+    long long node = findKey(word, nullptr);
+    if (node < 0 || !isLive((uint32_t)node))
+        return false;
+
+    if (keyCounts.empty())
+        keyCounts.assign(terminalCount, 1);
+    uint32_t &references = keyCounts[keyIndex((uint32_t)node)];
+    if (references == 1)
+    {
+        setWeight(word, 0); // a tombstone must not lift its subtree's bound
+        keyCount--;
+    }
+    references--;
+    return true;
+}
+
+int StaticTrie::count(const string &word) const
+{
+    long long node = findKey(word, nullptr);
+    if (node < 0 || !isLive((uint32_t)node))
+        return 0;
+    return keyCounts.empty() ? 1 : (int)keyCounts[keyIndex((uint32_t)node)];
+}
+
+// A key's live IDs fill the front of its slots, so an add writes the first
+// free slot and a remove moves the last live ID into the hole
+bool StaticTrie::addRef(const string &word, int id)
+{
+    long long node = findKey(word, nullptr);
+    if (node < 0 || postings.empty())
+        return false;
+
+    uint32_t key = keyIndex((uint32_t)node);
+    uint32_t live = (uint32_t)count(word);
+    if (postingStart[key] + live == postingStart[key + 1])
+        return false;
+    postings[postingStart[key] + live] = id;
+    return addRef(word);
+}
+
+bool StaticTrie::remove(const string &word, int id)
+{
+    long long node = findKey(word, nullptr);
+    if (node < 0 || postings.empty())
+        return false;
+
+    uint32_t key = keyIndex((uint32_t)node);
+    int *first = postings.data() + postingStart[key];
+    int *last = first + count(word);
+    int *found = std::find(first, last, id);
+    if (found == last)
+        return false;
+    swap(*found, *(last - 1));
+    return remove(word);
+}
+
+vector<int> StaticTrie::idsOf(const string &word) const
+{
+    long long node = findKey(word, nullptr);
+    if (node < 0 || postings.empty())
+        return vector<int>();
+
+    const int *first = postings.data() + postingStart[keyIndex((uint32_t)node)];
+    return vector<int>(first, first + count(word));
+}
+
+// -----------RANKING-----------
+
+uint32_t StaticTrie::keyIndex(uint32_t node) const
+{
+    uint64_t below = terminal[node / 64] & ((1ULL << (node % 64)) - 1);
+    return terminalRank[node / 64] + (uint32_t)popCount(below);
+}
+
+uint32_t StaticTrie::ownWeight(uint32_t node) const
+{
+    if (keyWeights.empty() || !isTerminal(node))
+        return 0;
+    return keyWeights[keyIndex(node)];
+}
+
+void StaticTrie::refreshSubtreeMax(uint32_t node)
+{
+    uint32_t first, count;
+    children(node, first, count);
+
+    uint32_t best = ownWeight(node);
+    for (uint32_t i = 0; i < count; i++)
+        best = max(best, subtreeMax[first + i]);
+    subtreeMax[node] = best;
+}
+
+bool StaticTrie::setWeight(const string &word, uint32_t weight)
+{
+    vector<uint32_t> ancestors;
+    long long node = findKey(word, &ancestors);
+    if (node < 0 || !isLive((uint32_t)node))
+        return false;
+
+    if (keyWeights.empty())
+    {
+        if (weight == 0)
+            return true;
+        keyWeights.assign(terminalCount, 0);
+        subtreeMax.assign(labels.size(), 0);
+    }
+
+    keyWeights[keyIndex((uint32_t)node)] = weight;
+    refreshSubtreeMax((uint32_t)node);
+    for (size_t i = ancestors.size(); i > 0; i--)
+        refreshSubtreeMax(ancestors[i - 1]);
+    return true;
+}
+
+uint32_t StaticTrie::weightOf(const string &word) const
+{
+    long long node = findKey(word, nullptr);
+    return node < 0 || !isLive((uint32_t)node) ? 0 : ownWeight((uint32_t)node);
+}
+
+// Same best-first search as RadixTrie::bestFirst, started from several
+// subtrees at once. Without weights every bound is 0 and it reduces to the
+// first k keys in order.
+void StaticTrie::bestFirst(const vector<pair<uint32_t, string>> &roots, int k, vector<pair<uint32_t, string>> &out) const
+{
+    struct Record
+    {
+        uint32_t node;
+        string path;
+    };
+    struct Entry
+    {
+        uint32_t weight;
+        int record;
+        bool isKey;
+    };
+
+    auto bound = [this](uint32_t node)
+    { return subtreeMax.empty() ? 0 : subtreeMax[node]; };
+
+    vector<Record> records;
+    auto lower = [&records](const Entry &a, const Entry &b)
+    {
+        if (a.weight != b.weight)
+            return a.weight < b.weight;
+        int order = records[a.record].path.compare(records[b.record].path);
+        return order != 0 ? order > 0 : a.isKey < b.isKey;
+    };
+    priority_queue<Entry, vector<Entry>, decltype(lower)> queue(lower);
+    for (const pair<uint32_t, string> &root : roots)
+    {
+        records.push_back(Record{root.first, root.second});
+        queue.push(Entry{bound(root.first), (int)records.size() - 1, false});
+    }
+
+    string path;
+    int found = 0;
+    while (!queue.empty() && found < k)
+    {
+        Entry entry = queue.top();
+        queue.pop();
+
+        if (entry.isKey)
+        {
+            out.emplace_back(entry.weight, records[entry.record].path);
+            found++;
+            continue;
+        }
+
+        uint32_t node = records[entry.record].node;
+        path = records[entry.record].path; // records may grow below
+        uint32_t first, count;
+        children(node, first, count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            records.push_back(Record{first + i, path + (char)labels[first + i]});
+            queue.push(Entry{bound(first + i), (int)records.size() - 1, false});
+        }
+        if (isLive(node))
+            queue.push(Entry{ownWeight(node), entry.record, true});
+    }
+}
+
+vector<string> StaticTrie::getAutoComplete(const string &prefix, int k) const
+{
+    vector<string> results;
+    long long start = k > 0 ? findPrefix(prefix) : -1;
+    if (start < 0)
+        return results;
+
+    vector<pair<uint32_t, string>> ranked;
+    bestFirst({{(uint32_t)start, prefix}}, k, ranked);
+    for (pair<uint32_t, string> &entry : ranked)
+        results.push_back(std::move(entry.second));
+    return results;
+}
+
+// -----------FUZZY-----------
+
+// Depth-first, carrying one row of the Levenshtein table per level: row[j]
+// is the distance between the path so far and the first j query bytes. A
+// row never has a smaller minimum than its parent's, which bounds a whole
+// subtree: once the minimum passes maxEdits nothing below can match, and
+// once it reaches the best prefix distance found on the path nothing below
+// can improve on it, so the subtree is taken whole at that distance.
+vector<string> StaticTrie::getFuzzyAutoComplete(const string &prefix, int maxEdits, int k) const
+{
+    vector<string> results;
+    if (k <= 0 || maxEdits < 0)
+        return results;
+
+    string query;
+    for (char c : prefix)
+    {
+        int byte = keyByte(c);
+        if (byte >= 0)
+            query.push_back((char)byte);
+    }
+    size_t width = query.size() + 1;
+
+    // subtrees[d] / keys[d]: matches at prefix distance d
+    vector<vector<pair<uint32_t, string>>> subtrees(maxEdits + 1), keys(maxEdits + 1);
+
+    struct Frame
+    {
+        uint32_t node;
+        uint32_t depth;
+        int best; // smallest prefix distance on the path above
+    };
+    vector<uint16_t> rows(width);
+    for (size_t j = 0; j < width; j++)
+        rows[j] = (uint16_t)j;
+    vector<Frame> stack(1, Frame{0, 0, (int)width});
+    string path;
+
+    while (!stack.empty())
+    {
+        Frame frame = stack.back();
+        stack.pop_back();
+
+        const uint16_t *row = rows.data() + frame.depth * width;
+        if (frame.depth > 0)
+        {
+            // Row for this node from its parent's, which is still in place:
+            // everything visited since lies deeper in the parent's subtree
+            path.resize(frame.depth - 1);
+            path.push_back((char)labels[frame.node]);
+            if (rows.size() < (frame.depth + 1) * width)
+                rows.resize((frame.depth + 1) * width);
+            const uint16_t *above = rows.data() + (frame.depth - 1) * width;
+            uint16_t *current = rows.data() + frame.depth * width;
+            current[0] = (uint16_t)(above[0] + 1);
+            for (size_t j = 1; j < width; j++)
+            {
+                uint16_t substitute = (uint16_t)(above[j - 1] + (query[j - 1] != path.back()));
+                current[j] = min(substitute, (uint16_t)(min(above[j], current[j - 1]) + 1));
+            }
+            row = current;
+        }
+
+        int rowMin = *min_element(row, row + width);
+        int best = min(frame.best, (int)row[width - 1]);
+        if (best <= maxEdits && rowMin >= best)
+        {
+            subtrees[best].emplace_back(frame.node, path);
+            continue;
+        }
+        if (rowMin > maxEdits)
+            continue;
+
+        if (best <= maxEdits && isLive(frame.node))
+            keys[best].emplace_back(ownWeight(frame.node), path);
+
+        uint32_t first, count;
+        children(frame.node, first, count);
+        for (uint32_t i = count; i > 0; i--)
+            stack.push_back(Frame{first + i - 1, frame.depth + 1, best});
+    }
+
+    // Closest first; within a distance, heaviest first, then by title
+    vector<pair<uint32_t, string>> level;
+    for (int distance = 0; distance <= maxEdits && (int)results.size() < k; distance++)
+    {
+        int wanted = k - (int)results.size();
+        level.clear();
+        bestFirst(subtrees[distance], wanted, level);
+        level.insert(level.end(), keys[distance].begin(), keys[distance].end());
+        sort(level.begin(), level.end(), [](const pair<uint32_t, string> &a, const pair<uint32_t, string> &b)
+             { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+        for (int i = 0; i < (int)level.size() && i < wanted; i++)
+            results.push_back(std::move(level[i].second));
+    }
+    return results;
+}
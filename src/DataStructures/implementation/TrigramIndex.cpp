@@ -0,0 +1,118 @@
+#include "../header/TrigramIndex.h"
+#include <algorithm>
+#include <cctype>
+
+TrigramIndex::TrigramIndex()
+{
+    postings = new HashTable<int, vector<int>>();
+}
+
+TrigramIndex::~TrigramIndex()
+{
+    delete postings;
+}
+
+vector<int> TrigramIndex::trigramsOf(const string &text)
+{
+    vector<int> trigrams;
+    if (text.size() < (size_t)MIN_TERM_LENGTH)
+        return trigrams;
+
+    trigrams.reserve(text.size() - 2);
+    int packed = 0;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        packed = ((packed << 8) | tolower((unsigned char)text[i])) & 0xFFFFFF;
+        if (i >= 2)
+            trigrams.push_back(packed);
+    }
+    sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void TrigramIndex::add(int id, const string &text)
+{
+    for (int trigram : trigramsOf(text))
+    {
+        vector<int> *ids = postings->try_emplace(trigram).first;
+        if (ids->empty() || ids->back() < id)
+        {
+            ids->push_back(id);
+            continue;
+        }
+        vector<int>::iterator at = lower_bound(ids->begin(), ids->end(), id);
+        if (*at != id)
+            ids->insert(at, id);
+    }
+}
+
+void TrigramIndex::remove(int id, const string &text)
+{
+    for (int trigram : trigramsOf(text))
+    {
+        vector<int> *ids = postings->search(trigram);
+        if (!ids)
+            continue;
+        vector<int>::iterator at = lower_bound(ids->begin(), ids->end(), id);
+        if (at == ids->end() || *at != id)
+            continue;
+        ids->erase(at);
+        if (ids->empty())
+            postings->remove(trigram);
+    }
+}
+
+void TrigramIndex::clear()
+{
+    delete postings;
+    postings = new HashTable<int, vector<int>>();
+}
+
+bool TrigramIndex::candidates(const string &term, vector<int> &out) const
+{
+    vector<int> trigrams = trigramsOf(term);
+    if (trigrams.empty())
+        return false;
+
+    vector<const vector<int> *> lists;
+    for (int trigram : trigrams)
+    {
+        const vector<int> *ids = postings->search(trigram);
+        if (!ids)
+        {
+            out.clear(); // a trigram nobody has: no text contains term
+            return true;
+        }
+        lists.push_back(ids);
+    }
+    sort(lists.begin(), lists.end(), [](const vector<int> *a, const vector<int> *b)
+         { return a->size() < b->size(); });
+
+    // Start from the shortest list and keep the IDs every other list has.
+    // Both sides are sorted, so each search starts where the last one ended.
+    out.assign(lists[0]->begin(), lists[0]->end());
+    for (size_t i = 1; i < lists.size() && !out.empty(); i++)
+    {
+        vector<int>::const_iterator from = lists[i]->begin();
+        size_t kept = 0;
+        for (int id : out)
+        {
+            from = lower_bound(from, lists[i]->end(), id);
+            if (from == lists[i]->end())
+                break;
+            if (*from == id)
+                out[kept++] = id;
+        }
+        out.resize(kept);
+    }
+    return true;
+}
+
+size_t TrigramIndex::memoryBytes() const
+{
+    size_t bytes = 0;
+    postings->forEach([&](const int &, const vector<int> &ids)
+                      { bytes += ids.capacity() * sizeof(int); });
+    return bytes;
+}
@@ -1,13 +1,15 @@
 #include "../header/linkedList.h"
 #include <string>
 #include <vector>
+#include <new>
+#include <type_traits>
 using namespace std;
 
-template <typename T>
-LinkedList<T>::LinkedList() : head(nullptr) {}
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList() : head(nullptr), tail(nullptr), count(0) {}
 
-template <typename T>
-LinkedList<T>::LinkedList(const LinkedList &other) : head(nullptr)
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList(const LinkedList &other) : head(nullptr), tail(nullptr), count(0)
 {
     Node<T> *temp = other.head;
     while (temp)
@@ -17,19 +19,60 @@ LinkedList<T>::LinkedList(const LinkedList &other) : head(nullptr)
     }
 }
 
-template <typename T>
-LinkedList<T>::~LinkedList()
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::LinkedList(LinkedList &&other) noexcept
+    : head(other.head), tail(other.tail), count(other.count), nodeAllocator(std::move(other.nodeAllocator))
 {
-    clear();
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.count = 0;
+}
+
+template <typename T, typename Alloc>
+LinkedList<T, Alloc>::~LinkedList()
+{
+    destroyAll();
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::destroyAll()
+{
+    if (!Alloc::RELEASES_IN_BULK)
+    {
+        clear();
+        return;
+    }
+
+    // Run element destructors only; the slabs are freed in one go
+    if (!std::is_trivially_destructible<T>::value)
+    {
+        Node<T> *temp = head;
+        while (temp)
+        {
+            Node<T> *next = temp->next;
+            temp->~Node<T>();
+            temp = next;
+        }
+    }
+    head = nullptr;
+    tail = nullptr;
+    count = 0;
+    nodeAllocator.releaseAll();
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::destroyNode(Node<T> *node)
+{
+    node->~Node<T>();
+    nodeAllocator.deallocate(node, sizeof(Node<T>));
 }
 
-template <typename T>
-LinkedList<T> &LinkedList<T>::operator=(const LinkedList &other)
+template <typename T, typename Alloc>
+LinkedList<T, Alloc> &LinkedList<T, Alloc>::operator=(const LinkedList &other)
 {
     if (this == &other)
         return *this;
     clear();
-    head = nullptr;
     Node<T> *temp = other.head;
     while (temp)
     {
@@ -39,26 +82,48 @@ LinkedList<T> &LinkedList<T>::operator=(const LinkedList &other)
     return *this;
 }
 
-template <typename T>
-void LinkedList<T>::insertAtEnd(const T &data)
+template <typename T, typename Alloc>
+LinkedList<T, Alloc> &LinkedList<T, Alloc>::operator=(LinkedList &&other) noexcept
 {
-    Node<T> *node = new Node<T>(data);
+    if (this == &other)
+        return *this;
+    destroyAll();
+    head = other.head;
+    tail = other.tail;
+    count = other.count;
+    nodeAllocator = std::move(other.nodeAllocator);
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.count = 0;
+    return *this;
+}
 
-    if (!head)
-    {
-        head = node;
-        return;
-    }
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::insertAtEnd(const T &data)
+{
+    appendNode(createNode(data));
+}
 
-    Node<T> *temp = head;
-    while (temp->next)
-        temp = temp->next;
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::insertAtEnd(T &&data)
+{
+    appendNode(createNode(std::move(data)));
+}
+
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::appendNode(Node<T> *node)
+{
+    if (tail)
+        tail->next = node;
+    else
+        head = node;
 
-    temp->next = node;
+    tail = node;
+    count++;
 }
 
-template <typename T>
-bool LinkedList<T>::remove(const T &data)
+template <typename T, typename Alloc>
+bool LinkedList<T, Alloc>::remove(const T &data)
 {
     Node<T> *temp = head;
     Node<T> *prev = nullptr;
@@ -71,8 +136,11 @@ bool LinkedList<T>::remove(const T &data)
                 prev->next = temp->next;
             else
                 head = temp->next;
+            if (temp == tail)
+                tail = prev;
 
-            delete temp;
+            destroyNode(temp);
+            count--;
             return true;
         }
         prev = temp;
@@ -81,8 +149,8 @@ bool LinkedList<T>::remove(const T &data)
     return false;
 }
 
-template <typename T>
-bool LinkedList<T>::search(const T &data)
+template <typename T, typename Alloc>
+bool LinkedList<T, Alloc>::search(const T &data)
 {
     Node<T> *temp = head;
     while (temp)
@@ -94,23 +162,26 @@ bool LinkedList<T>::search(const T &data)
     return false;
 }
 
-template <typename T>
-void LinkedList<T>::clear()
+template <typename T, typename Alloc>
+void LinkedList<T, Alloc>::clear()
 {
     Node<T> *temp = head;
     while (temp)
     {
         Node<T> *next = temp->next;
-        delete temp;
+        destroyNode(temp);
         temp = next;
     }
     head = nullptr;
+    tail = nullptr;
+    count = 0;
 }
 
-template <typename T>
-std::vector<T> LinkedList<T>::toVector() const
+template <typename T, typename Alloc>
+std::vector<T> LinkedList<T, Alloc>::toVector() const
 {
     std::vector<T> out;
+    out.reserve(count);
     Node<T> *temp = head;
     while (temp)
     {
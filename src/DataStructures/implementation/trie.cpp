@@ -1,15 +1,41 @@
 #include "../header/trie.h"
+#include <cctype>
+#include <new>
 
 TrieNode::TrieNode()
 {
-    isEnd = false;
+    count = 0;
+    childMask[0] = childMask[1] = 0;
     for (int i = 0; i < 128; i++)
         children[i] = nullptr;
 }
 
 Trie::Trie()
 {
-    root = new TrieNode();
+    root = newNode();
+}
+
+// TrieNode is trivially destructible, so releasing the slabs is all the
+// teardown there is
+Trie::~Trie()
+{
+    nodeAllocator.releaseAll();
+}
+
+TrieNode *Trie::newNode()
+{
+    return new (nodeAllocator.allocate(sizeof(TrieNode))) TrieNode();
+}
+
+void Trie::freeNode(TrieNode *node)
+{
+    nodeAllocator.deallocate(node, sizeof(TrieNode));
+}
+
+void Trie::clear()
+{
+    nodeAllocator.releaseAll();
+    root = newNode();
 }
 
 void Trie::insert(const string &word)
@@ -21,13 +47,62 @@ void Trie::insert(const string &word)
         if (idx < 0 || idx >= 128)
             continue;
         if (!node->children[idx])
-            node->children[idx] = new TrieNode();
+        {
+            node->children[idx] = newNode();
+            node->childMask[idx / 64] |= 1ULL << (idx % 64);
+        }
         node = node->children[idx];
     }
-    node->isEnd = true;
+    node->count++;
 }
 
-TrieNode *Trie::searchPrefix(const string &prefix)
+bool Trie::remove(const string &word)
+{
+    // Walk down as insert() did, remembering the highest node that would
+    // be left empty: everything from there down belongs to word alone
+    TrieNode *node = root;
+    TrieNode *cutParent = nullptr;
+    int cutByte = 0;
+    for (char c : word)
+    {
+        int idx = (unsigned char)tolower(c);
+        if (idx < 0 || idx >= 128)
+            continue;
+        TrieNode *child = node->children[idx];
+        if (!child)
+            return false;
+
+        // Compare the mask words separately: OR-ing them would merge bytes 64 apart
+        bool onlyChild = node->childMask[idx / 64] == (1ULL << (idx % 64)) && node->childMask[1 - idx / 64] == 0;
+        if (node == root || node->count > 0 || !onlyChild)
+        {
+            cutParent = node;
+            cutByte = idx;
+        }
+        node = child;
+    }
+    if (node->count == 0)
+        return false;
+
+    node->count--;
+    if (node->count > 0 || node->childMask[0] || node->childMask[1] || !cutParent)
+        return true;
+
+    // Each node below the cut has exactly one child down to word's node
+    TrieNode *doomed = cutParent->children[cutByte];
+    cutParent->children[cutByte] = nullptr;
+    cutParent->childMask[cutByte / 64] &= ~(1ULL << (cutByte % 64));
+    while (doomed)
+    {
+        int byte = nextChild(doomed, 0);
+        TrieNode *next = byte < 0 ? nullptr : doomed->children[byte];
+        freeNode(doomed);
+        doomed = next;
+    }
+    return true;
+}
+
+TrieNode *Trie::searchPrefix(const string &prefix) const
 {
     TrieNode *node = root;
     for (char c : prefix)
@@ -42,27 +117,113 @@ TrieNode *Trie::searchPrefix(const string &prefix)
     return node;
 }
 
-void Trie::collect(TrieNode *node, string prefix, vector<string> &results)
+int Trie::nextChild(const TrieNode *node, int from)
+{
+    for (int word = from / 64; word < 2; word++)
+    {
+        uint64_t bits = node->childMask[word];
+        if (word == from / 64)
+            bits &= ~0ULL << (from % 64);
+        if (bits)
+            return word * 64 + __builtin_ctzll(bits);
+    }
+    return -1;
+}
+
+bool Trie::open(const string &prefix, TrieCursor &cursor) const
 {
-    if (!node)
-        return;
+    if (cursor.started && cursor.finished && cursor.prefix == prefix)
+        return false;
 
-    if (node->isEnd)
-        results.push_back(prefix);
+    TrieNode *start = searchPrefix(prefix);
+    cursor.stack.clear();
+    if (!start)
+    {
+        cursor.started = cursor.finished = true;
+        cursor.prefix = prefix;
+        return false;
+    }
+    cursor.stack.push_back({start, 0});
 
-    for (int i = 0; i < 128; i++)
-        if (node->children[i])
-            collect(node->children[i], prefix + char(i), results);
+    if (!cursor.started || cursor.prefix != prefix)
+    {
+        cursor.prefix = prefix;
+        cursor.path = prefix;
+        cursor.started = true;
+        cursor.finished = false;
+        cursor.emitStart = start->count > 0;
+        return true;
+    }
+
+    // Resume: walk down to the last completion emitted. If part of its
+    // path is gone, continue with the next sibling of the missing byte.
+    cursor.emitStart = false;
+    const string &last = cursor.path;
+    for (size_t i = prefix.size(); i < last.size(); i++)
+    {
+        int byte = (unsigned char)last[i];
+        TrieFrame &top = cursor.stack.back();
+        const TrieNode *child = byte < 128 ? top.node->children[byte] : nullptr;
+        if (!child)
+        {
+            top.next = byte;
+            cursor.path.resize(i);
+            return true;
+        }
+        top.next = byte + 1;
+        cursor.stack.push_back({child, 0});
+    }
+    return true;
 }
 
-vector<string> Trie::getAutoComplete(const string &prefix)
+bool Trie::advance(TrieCursor &cursor) const
 {
-    vector<string> results;
-    TrieNode *start = searchPrefix(prefix);
+    if (cursor.emitStart)
+    {
+        cursor.emitStart = false;
+        return true;
+    }
 
-    if (!start)
-        return results;
+    // Depth-first in byte order; cursor.path always spells the path to the
+    // top frame, so a step down appends one byte and a step up removes one
+    while (!cursor.stack.empty())
+    {
+        TrieFrame &top = cursor.stack.back();
+        int byte = nextChild(top.node, top.next);
+        if (byte < 0)
+        {
+            cursor.stack.pop_back();
+            if (!cursor.stack.empty())
+                cursor.path.pop_back();
+            continue;
+        }
+        top.next = byte + 1;
+        const TrieNode *child = top.node->children[byte];
+        cursor.path.push_back(char(byte));
+        cursor.stack.push_back({child, 0});
+        if (child->count > 0)
+            return true;
+    }
+    cursor.finished = true;
+    return false;
+}
+
+bool Trie::pending(const TrieCursor &cursor) const
+{
+    // Every node lies on the path of some key, so any untried child leads to one
+    if (cursor.emitStart)
+        return true;
+    for (const TrieFrame &frame : cursor.stack)
+        if (nextChild(frame.node, frame.next) >= 0)
+            return true;
+    return false;
+}
 
-    collect(start, prefix, results);
+vector<string> Trie::getAutoComplete(const string &prefix)
+{
+    vector<string> results;
+    TrieCursor cursor;
+    forEachCompletion(prefix, cursor, [&](const string &completion)
+                      { results.push_back(completion); });
     return results;
 }
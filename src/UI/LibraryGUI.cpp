@@ -18,11 +18,19 @@ LibraryGUI::LibraryGUI(QWidget *parent)
     // Link borrower with book manager
     borrower->setBookManager(bookManager);
 
+    // Most ID and user lookups from the search boxes are misses
+    bookManager->enableBloomFilter(0.01);
+    borrower->enableBloomFilter(0.01);
+
     // Load initial data
     bookManager->loadBooksFromCSV("D:/HP/Projects/DSAE/Optimized-Library-Lookup-System/data/book.csv");
     searchAndSort->loadAllBooksToTrie();
     borrower->loadBorrowRecordsFromCSV("D:/HP/Projects/DSAE/Optimized-Library-Lookup-System/data/borrow_records.csv");
 
+    // Rank suggestions by how often each title has been borrowed
+    borrower->forEachBorrowCount([&](const std::string &title, const int &count)
+                                 { searchAndSort->setTitleWeight(title, (uint32_t)count); });
+
     // Setup UI
     setupUI();
 
@@ -128,9 +136,10 @@ LibraryGUI::LibraryGUI(QWidget *parent)
 
 LibraryGUI::~LibraryGUI()
 {
-    delete bookManager;
+    // Modules that hold the manager go first
     delete searchAndSort;
     delete borrower;
+    delete bookManager;
 }
 
 void LibraryGUI::setupUI()
@@ -438,7 +447,6 @@ void LibraryGUI::handleAddBook()
         }
 
         bookManager->addBook(id, title, author, year, publisher);
-        searchAndSort->addToAutoComplete(title);
 
         updateStatusMessage("✅ Book added successfully!");
         bookStatusLabel->setStyleSheet("QLabel { color: #1a7f37; font-weight: 600; }");
@@ -521,27 +529,27 @@ void LibraryGUI::handleSearchBook()
     try
     {
         int id = std::stoi(bookIdInput->text().toStdString());
-        Book *book = bookManager->searchBook(id);
+        Book book;
 
-        if (book)
+        if (bookManager->searchBook(id, book))
         {
             bookDisplayList->clear();
             std::stringstream ss;
-            ss << "📖 ID: " << book->getId()
-               << " | Title: " << book->getTitle()
-               << " | Author: " << book->getAuthor()
-               << " | Year: " << book->getYear()
-               << " | Publisher: " << book->getPublisher();
+            ss << "📖 ID: " << book.getId()
+               << " | Title: " << book.getTitle()
+               << " | Author: " << book.getAuthor()
+               << " | Year: " << book.getYear()
+               << " | Publisher: " << book.getPublisher();
 
             bookDisplayList->addItem(QString::fromStdString(ss.str()));
             updateStatusMessage("✅ Book found!");
             bookStatusLabel->setStyleSheet("QLabel { color: #1a7f37; font-weight: 600; }");
 
             // Populate fields
-            bookTitleInput->setText(QString::fromStdString(book->getTitle()));
-            bookAuthorInput->setText(QString::fromStdString(book->getAuthor()));
-            bookYearInput->setText(QString::number(book->getYear()));
-            bookPublisherInput->setText(QString::fromStdString(book->getPublisher()));
+            bookTitleInput->setText(QString::fromStdString(book.getTitle()));
+            bookAuthorInput->setText(QString::fromStdString(book.getAuthor()));
+            bookYearInput->setText(QString::number(book.getYear()));
+            bookPublisherInput->setText(QString::fromStdString(book.getPublisher()));
         }
         else
         {
@@ -608,8 +616,11 @@ void LibraryGUI::handleSearchByTitle()
         return;
     }
 
-    std::vector<Book> results = searchAndSort->searchBooksByTitle(searchTerm);
+    showTitleSearchResults(searchAndSort->searchBooksByTitle(searchTerm));
+}
 
+void LibraryGUI::showTitleSearchResults(const std::vector<Book> &results)
+{
     searchResultsList->clear();
 
     if (results.empty())
@@ -636,28 +647,26 @@ void LibraryGUI::handleSearchByTitle()
 
 void LibraryGUI::handleSortByTitle()
 {
-    std::vector<std::pair<int, Book>> allBooks = bookManager->getAllBooks();
-
-    if (allBooks.empty())
+    if (bookManager->getBookCount() == 0)
     {
         updateSearchStatus("❌ No books to sort.");
         searchStatusLabel->setStyleSheet("QLabel { color: #cf222e; font-weight: 600; }");
         return;
     }
 
-    // Convert to array of pointers for sorting
+    // Copy the books out: forEachBook's reference only lives for the
+    // callback (snapshot books are built on the fly)
     std::vector<Book> bookVec;
-    for (const auto &pair : allBooks)
-    {
-        bookVec.push_back(pair.second);
-    }
+    bookVec.reserve(bookManager->getBookCount());
+    bookManager->forEachBook([&](const Book &book)
+                             { bookVec.push_back(book); });
 
     // Sort using merge sort (in-place via vector)
     std::sort(bookVec.begin(), bookVec.end(), [](const Book &a, const Book &b)
               { return a.getTitle() < b.getTitle(); });
 
     searchResultsList->clear();
-    for (const auto &book : bookVec)
+    for (const Book &book : bookVec)
     {
         std::stringstream ss;
         ss << "📖 " << book.getTitle()
@@ -673,26 +682,25 @@ void LibraryGUI::handleSortByTitle()
 
 void LibraryGUI::handleSortByYear()
 {
-    std::vector<std::pair<int, Book>> allBooks = bookManager->getAllBooks();
-
-    if (allBooks.empty())
+    if (bookManager->getBookCount() == 0)
     {
         updateSearchStatus("❌ No books to sort.");
         searchStatusLabel->setStyleSheet("QLabel { color: #cf222e; font-weight: 600; }");
         return;
     }
 
+    // Copy the books out: forEachBook's reference only lives for the
+    // callback (snapshot books are built on the fly)
     std::vector<Book> bookVec;
-    for (const auto &pair : allBooks)
-    {
-        bookVec.push_back(pair.second);
-    }
+    bookVec.reserve(bookManager->getBookCount());
+    bookManager->forEachBook([&](const Book &book)
+                             { bookVec.push_back(book); });
 
     std::sort(bookVec.begin(), bookVec.end(), [](const Book &a, const Book &b)
               { return a.getYear() < b.getYear(); });
 
     searchResultsList->clear();
-    for (const auto &book : bookVec)
+    for (const Book &book : bookVec)
     {
         std::stringstream ss;
         ss << "📅 " << book.getYear()
@@ -708,26 +716,25 @@ void LibraryGUI::handleSortByYear()
 
 void LibraryGUI::handleSortByAuthor()
 {
-    std::vector<std::pair<int, Book>> allBooks = bookManager->getAllBooks();
-
-    if (allBooks.empty())
+    if (bookManager->getBookCount() == 0)
     {
         updateSearchStatus("❌ No books to sort.");
         searchStatusLabel->setStyleSheet("QLabel { color: #cf222e; font-weight: 600; }");
         return;
     }
 
+    // Copy the books out: forEachBook's reference only lives for the
+    // callback (snapshot books are built on the fly)
     std::vector<Book> bookVec;
-    for (const auto &pair : allBooks)
-    {
-        bookVec.push_back(pair.second);
-    }
+    bookVec.reserve(bookManager->getBookCount());
+    bookManager->forEachBook([&](const Book &book)
+                             { bookVec.push_back(book); });
 
     std::sort(bookVec.begin(), bookVec.end(), [](const Book &a, const Book &b)
               { return a.getAuthor() < b.getAuthor(); });
 
     searchResultsList->clear();
-    for (const auto &book : bookVec)
+    for (const Book &book : bookVec)
     {
         std::stringstream ss;
         ss << "👤 " << book.getAuthor()
@@ -758,7 +765,18 @@ void LibraryGUI::handleSearchTermChanged()
         return;
     }
 
-    std::vector<std::string> suggestions = searchAndSort->autoComplete(prefix);
+    // Only the most borrowed few fit the list, so stop the search there
+    std::vector<std::pair<std::string, std::vector<int>>> suggestions = searchAndSort->autoCompleteBooks(prefix, 10);
+
+    // Nothing starts with what was typed: offer near misses, allowing a
+    // second typo once there is enough text to tell titles apart
+    if (suggestions.empty() && prefix.size() >= 3)
+    {
+        for (const std::string &title : searchAndSort->fuzzyAutoComplete(prefix, prefix.size() >= 6 ? 2 : 1, 10))
+        {
+            suggestions.emplace_back(title, searchAndSort->bookIdsForTitle(title));
+        }
+    }
 
     suggestionsList->clear();
 
@@ -770,7 +788,15 @@ void LibraryGUI::handleSearchTermChanged()
     {
         for (const auto &suggestion : suggestions)
         {
-            suggestionsList->addItem(QString::fromStdString("📚 " + suggestion));
+            // Keep the books' IDs with the item, so a click needs no title search
+            QListWidgetItem *item = new QListWidgetItem(QString::fromStdString("📚 " + suggestion.first));
+            QVariantList ids;
+            for (int id : suggestion.second)
+            {
+                ids.append(id);
+            }
+            item->setData(Qt::UserRole, ids);
+            suggestionsList->addItem(item);
         }
     }
 }
@@ -786,8 +812,27 @@ void LibraryGUI::handleSuggestionClick()
         {
             text = text.mid(3); // Remove first 3 characters (emoji + space)
         }
+        // Read before setText(), which refills the list and deletes item
+        QVariantList ids = item->data(Qt::UserRole).toList();
         searchTermInput->setText(text);
-        handleSearchByTitle(); // Auto-search when suggestion is clicked
+
+        // Show the suggestion's own books: one ID lookup each
+        if (ids.isEmpty())
+        {
+            handleSearchByTitle(); // Auto-search when suggestion is clicked
+            return;
+        }
+
+        std::vector<Book> results;
+        for (const QVariant &id : ids)
+        {
+            Book book;
+            if (bookManager->searchBook(id.toInt(), book))
+            {
+                results.push_back(book);
+            }
+        }
+        showTitleSearchResults(results);
     }
 }
 
@@ -809,6 +854,8 @@ void LibraryGUI::handleBorrowBook()
 
     if (success)
     {
+        searchAndSort->setTitleWeight(bookTitle, (uint32_t)borrower->getBorrowCount(bookTitle));
+
         updateBorrowerStatus("✅ Book borrowed successfully!");
         borrowerStatusLabel->setStyleSheet("QLabel { color: #1a7f37; font-weight: 600; }");
 
@@ -867,7 +914,7 @@ void LibraryGUI::handleViewUserBorrows()
         return;
     }
 
-    LinkedList<std::string> *borrows = borrower->getUserActiveBorrows(userName);
+    const LoanList *borrows = borrower->getUserActiveBorrows(userName);
 
     borrowerResultsList->clear();
 
@@ -879,8 +926,7 @@ void LibraryGUI::handleViewUserBorrows()
     }
     else
     {
-        std::vector<std::string> borrowVec = borrows->toVector();
-        if (borrowVec.empty())
+        if (borrows->empty())
         {
             borrowerResultsList->addItem(QString::fromUtf8("ℹ️ No active borrows for this user."));
             updateBorrowerStatus("ℹ️ No active borrows found.");
@@ -888,11 +934,11 @@ void LibraryGUI::handleViewUserBorrows()
         }
         else
         {
-            for (const auto &record : borrowVec)
+            for (const Loan &loan : *borrows)
             {
-                borrowerResultsList->addItem(QString::fromStdString("📚 " + record));
+                borrowerResultsList->addItem(QString::fromStdString("📚 " + loan.title + "|" + loan.date));
             }
-            updateBorrowerStatus("✅ Found " + std::to_string(borrowVec.size()) + " active borrow(s).");
+            updateBorrowerStatus("✅ Found " + std::to_string(borrows->size()) + " active borrow(s).");
             borrowerStatusLabel->setStyleSheet("QLabel { color: #1a7f37; font-weight: 600; }");
         }
     }
@@ -909,7 +955,7 @@ void LibraryGUI::handleViewBookBorrowers()
         return;
     }
 
-    LinkedList<std::string> *borrowers = borrower->getBookActiveBorrowers(bookTitle);
+    const LoanList *borrowers = borrower->getBookActiveBorrowers(bookTitle);
 
     borrowerResultsList->clear();
 
@@ -921,8 +967,7 @@ void LibraryGUI::handleViewBookBorrowers()
     }
     else
     {
-        std::vector<std::string> borrowerVec = borrowers->toVector();
-        if (borrowerVec.empty())
+        if (borrowers->empty())
         {
             borrowerResultsList->addItem(QString::fromUtf8("ℹ️ No active borrowers for this book."));
             updateBorrowerStatus("ℹ️ No active borrowers found.");
@@ -930,11 +975,11 @@ void LibraryGUI::handleViewBookBorrowers()
         }
         else
         {
-            for (const auto &record : borrowerVec)
+            for (const Loan &loan : *borrowers)
             {
-                borrowerResultsList->addItem(QString::fromStdString("👤 " + record));
+                borrowerResultsList->addItem(QString::fromStdString("👤 " + loan.user + "|" + loan.date));
             }
-            updateBorrowerStatus("✅ Found " + std::to_string(borrowerVec.size()) + " active borrower(s).");
+            updateBorrowerStatus("✅ Found " + std::to_string(borrowers->size()) + " active borrower(s).");
             borrowerStatusLabel->setStyleSheet("QLabel { color: #1a7f37; font-weight: 600; }");
         }
     }
@@ -942,7 +987,7 @@ void LibraryGUI::handleViewBookBorrowers()
 
 void LibraryGUI::handleViewHistory()
 {
-    LinkedList<std::string> *history = borrower->getHistory();
+    HistoryLog *history = borrower->getHistory();
 
     borrowerHistoryList->clear();
 
@@ -954,9 +999,7 @@ void LibraryGUI::handleViewHistory()
     }
     else
     {
-        std::vector<std::string> historyVector = history->toVector();
-
-        if (historyVector.empty())
+        if (history->empty())
         {
             borrowerHistoryList->addItem(QString::fromUtf8("ℹ️ No history available."));
             updateBorrowerStatus("ℹ️ No history found.");
@@ -964,11 +1007,12 @@ void LibraryGUI::handleViewHistory()
         }
         else
         {
-            for (const auto &record : historyVector)
+            // Most recent first, read straight from the log
+            for (auto it = history->rbegin(); it != history->rend(); ++it)
             {
-                borrowerHistoryList->addItem(QString::fromStdString("📜 " + record));
+                borrowerHistoryList->addItem(QString::fromStdString("📜 " + (*it).toLine()));
             }
-            updateBorrowerStatus("✅ Displaying " + std::to_string(historyVector.size()) + " history record(s).");
+            updateBorrowerStatus("✅ Displaying " + std::to_string(history->size()) + " history record(s).");
             borrowerStatusLabel->setStyleSheet("QLabel { color: #1a7f37; font-weight: 600; }");
         }
     }
@@ -994,25 +1038,22 @@ void LibraryGUI::refreshBookDisplay()
 {
     bookDisplayList->clear();
 
-    std::vector<std::pair<int, Book>> allBooks = bookManager->getAllBooks();
-
-    if (allBooks.empty())
+    if (bookManager->getBookCount() == 0)
     {
         bookDisplayList->addItem(QString::fromUtf8("ℹ️ No books in the database."));
         return;
     }
 
-    for (const auto &pair : allBooks)
-    {
-        const Book &book = pair.second;
-        std::stringstream ss;
-        ss << "📖 ID: " << book.getId()
-           << " | Title: " << book.getTitle()
-           << " | Author: " << book.getAuthor()
-           << " | Year: " << book.getYear()
-           << " | Publisher: " << book.getPublisher();
-        bookDisplayList->addItem(QString::fromStdString(ss.str()));
-    }
+    bookManager->forEachBook([&](const Book &book)
+                             {
+                                 std::stringstream ss;
+                                 ss << "📖 ID: " << book.getId()
+                                    << " | Title: " << book.getTitle()
+                                    << " | Author: " << book.getAuthor()
+                                    << " | Year: " << book.getYear()
+                                    << " | Publisher: " << book.getPublisher();
+                                 bookDisplayList->addItem(QString::fromStdString(ss.str()));
+                             });
 }
 
 void LibraryGUI::updateStatusMessage(const std::string &message)
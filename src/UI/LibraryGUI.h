@@ -84,6 +84,7 @@ private:
     void updateStatusMessage(const std::string &message);
     void updateSearchStatus(const std::string &message);
     void showAutoCompleteSuggestions(const std::string &prefix);
+    void showTitleSearchResults(const std::vector<Book> &results);
 
 private slots:
     void handleAddBook();
@@ -16,12 +16,12 @@ public:
     Book();
     Book(int id, const string &title, const string &author, int year, const string &publisher = "Unknown Publisher");
 
-    // Getters
+    // Getters (strings by reference so scans do not copy them)
     int getId() const;
-    string getTitle() const;
-    string getAuthor() const;
+    const string &getTitle() const;
+    const string &getAuthor() const;
     int getYear() const;
-    string getPublisher() const;
+    const string &getPublisher() const;
 
     // Setters
     void setTitle(const string &newTitle);
@@ -6,10 +6,10 @@ Book::Book(int id, const string &title, const string &author, int year, const st
     : id(id), title(title), author(author), year(year), publisher(publisher) {}
 
 int Book::getId() const { return id; }
-string Book::getTitle() const { return title; }
-string Book::getAuthor() const { return author; }
+const string &Book::getTitle() const { return title; }
+const string &Book::getAuthor() const { return author; }
 int Book::getYear() const { return year; }
-string Book::getPublisher() const { return publisher; }
+const string &Book::getPublisher() const { return publisher; }
 
 void Book::setTitle(const string &newTitle) { title = newTitle; }
 void Book::setAuthor(const string &newAuthor) { author = newAuthor; }
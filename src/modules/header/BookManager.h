@@ -4,6 +4,12 @@
 //dependencies
 #include "../entities/header/book.h"               // include Book entity
 #include "../../DataStructures/header/HashTable.h" // include to Hash Table
+#include "../../DataStructures/header/FlatHashTable.h" // open-addressing alternative
+#include "../../DataStructures/header/EpochHashTable.h" // lock-free reads
+#include "../../DataStructures/header/DenseIdTable.h" // direct-indexed dense IDs
+#include "../../DataStructures/header/BookSnapshot.h" // memory-mapped catalog snapshot
+#include "../../DataStructures/header/TrigramIndex.h" // substring search over titles
+#include <functional>
 #include <string>
 #include <vector>
 #include <fstream> // Required for file handling
@@ -11,19 +17,69 @@
 #include <iostream>
 
 // Controls the operations related to books
-class BookManager
+// BookTable selects the storage: HashTable<int, Book> (chaining, default),
+// FlatHashTable<int, Book> (open addressing, cache-friendly lookups),
+// EpochHashTable<int, Book> (lock-free searchBook for many reader threads) or
+// DenseIdTable<Book> (contiguous records indexed directly by dense IDs).
+//
+// After openSnapshot() the catalog lives in a read-only mapped file and
+// bookTable becomes a copy-on-write overlay on top of it. Reads never copy
+// into the overlay: searchBook builds a snapshot book straight from the
+// mapping. Only updateBook copies one in (the edited version), and adds,
+// updates and deletes only ever change the overlay.
+
+// Set of snapshot IDs the overlay owns. ConcurrentBookManager readers look
+// IDs up in it while a writer adds to it, so that manager gets a set with
+// lock-free reads as well.
+template <typename BookTable>
+struct SnapshotShadowTable
+{
+    typedef HashTable<int, int> type;
+};
+
+template <>
+struct SnapshotShadowTable<EpochHashTable<int, Book>>
+{
+    typedef EpochHashTable<int, int> type;
+};
+
+template <typename BookTable = HashTable<int, Book>>
+class BasicBookManager
 {
 private:
     //Stores books using their ID as the unique key
-    HashTable<int, Book> *bookTable;
+    BookTable *bookTable;
     std::string csvFilePath; // Store the CSV file path for auto-saving
 
+    // Snapshot beneath the overlay (closed unless openSnapshot() succeeded)
+    BookSnapshot *snapshot;
+    // Snapshot IDs the overlay now owns: updated in bookTable or deleted
+    typedef typename SnapshotShadowTable<BookTable>::type ShadowTable;
+    ShadowTable *snapshotShadow;
+    double bloomFalsePositiveRate; // 0 while the filter is off
+
+    // Title trigrams for searchBookByTitle, kept in step by every add,
+    // update, delete and CSV load. After openSnapshot() it is rebuilt by
+    // the first title search, so opening stays independent of catalog size.
+    TrigramIndex *titleIndex;
+    bool titleIndexBuilt;
+
+    // Told of every title added, renamed or deleted (unset by default)
+    std::function<void(int id, const std::string &oldTitle, const std::string &newTitle)> titleObserver;
+
+    // True if the ID is in the overlay or a live snapshot record
+    bool containsBook(int id);
+    // Marks a snapshot ID as owned by the overlay
+    void shadowSnapshotBook(int id);
+    // Indexes every current title from scratch
+    void rebuildTitleIndex();
+
 public:
     // Constructor
-    BookManager();
+    BasicBookManager();
 
     // Destructor
-    ~BookManager();
+    ~BasicBookManager();
 
     // Adds a new book to the library and triggers an auto-save
     void addBook(int id, std::string title, std::string author, int year, std::string publisher = "Unknown");
@@ -34,20 +90,98 @@ public:
     // Updates details (Title, Author, Year) of an existing book. Returns true if successful.
     bool updateBook(int id, std::string newTitle, std::string newAuthor, int newYear);
 
-    // Reads the CSV file
+    // Reads the CSV file and bulk-loads it; a repeated ID keeps its last row
     void loadBooksFromCSV(std::string filename);
 
     // Overwrites the CSV file with current data to ensure changes are saved
     void saveBooksToCSV(std::string filename);
 
-    // O(1) complexity: Finds a book by its ID, returns nullptr if not found
-    Book *searchBook(int id);  
+    // File that addBook, updateBook and deleteBook save to (loadBooksFromCSV
+    // sets it too); empty turns auto-saving off
+    void setCsvFilePath(std::string filename) { csvFilePath = std::move(filename); }
+
+    // Writes the whole catalog (snapshot plus overlay) as a binary snapshot.
+    // On Windows the target must not be the snapshot that is currently open.
+    bool saveSnapshot(std::string filename);
+
+    // Maps a snapshot and makes it the catalog, discarding the current
+    // books and overlay. Only the header is checked unless verifyChecksum
+    // is set, so opening is independent of the catalog size.
+    bool openSnapshot(std::string filename, bool verifyChecksum = false);
+    bool hasSnapshot() const { return snapshot->isOpen(); }
+
+    // O(1) complexity: Copies the book with this ID into out, returns false if not found.
+    // Changes nothing: a snapshot book is read from the mapping, not copied into the overlay.
+    bool searchBook(int id, Book &out);
     
-    // O(N) complexity: Finds all books containing searched title, returns pointer to book if found, nullptr if not
-    std::vector<Book> searchBookByTitle(std::string title); // Search by title (case-insensitive partial match)
+    // Finds all books whose title contains the search term (case-insensitive), in ID order.
+    // Terms of 3+ characters go through the title index, costing about the number of
+    // books that share the term's rarest trigram; shorter ones scan every title.
+    std::vector<Book> searchBookByTitle(std::string title);
     
     // Converts Hash Table data into a Vector 
     std::vector<std::pair<int, Book>> getAllBooks();
+
+    // Calls visit(const Book &) for every book. Overlay books are visited in
+    // place; snapshot books are built from the mapping for the call, so the
+    // reference is only valid inside visit. Copy what must outlive it.
+    template <typename Visitor>
+    void forEachBook(Visitor visit) const;
+
+    // Number of books currently stored
+    int getBookCount() const { return bookTable->size() + snapshot->size() - snapshotShadow->size(); }
+
+    // Calls observer(id, oldTitle, newTitle) after each successful addBook
+    // (oldTitle empty), updateBook and deleteBook (newTitle empty), so an
+    // index over titles can follow edits one book at a time. Bulk loads
+    // (loadBooksFromCSV, openSnapshot) are not reported. One observer at a
+    // time; nullptr removes it.
+    void setTitleObserver(std::function<void(int id, const std::string &oldTitle, const std::string &newTitle)> observer)
+    {
+        titleObserver = std::move(observer);
+    }
+
+    // Lets searchBook/deleteBook answer unknown IDs from a Bloom filter
+    // without walking a bucket. Returns false if BookTable has no filter.
+    bool enableBloomFilter(double falsePositiveRate = 0.01);
+
+    // Lookups the filter answered on its own (0 without a filter)
+    long long bloomSkippedProbes() const;
 };
 
+template <typename BookTable>
+template <typename Visitor>
+void BasicBookManager<BookTable>::forEachBook(Visitor visit) const
+{
+    bookTable->forEach([&](const int &, const Book &book)
+                       { visit(book); });
+
+    // Snapshot books the overlay does not own are built on the fly
+    if (snapshot->isOpen())
+    {
+        bool anyShadowed = snapshotShadow->size() > 0;
+        snapshot->forEach([&](const SnapshotRecord &record)
+                          {
+                              if (!anyShadowed || !snapshotShadow->search(record.id))
+                                  visit(snapshot->toBook(record));
+                          });
+    }
+}
+
+// Default manager used by the GUI and Borrower
+typedef BasicBookManager<> BookManager;
+
+// Manager backed by the open-addressing table
+typedef BasicBookManager<FlatHashTable<int, Book>> FlatBookManager;
+
+// Manager for many concurrent readers and one writer at a time. Reader
+// threads wrap searchBook() in an EpochGuard; the copy it fills in is their
+// own. openSnapshot() replaces the tables outright, so it must not overlap
+// with readers.
+typedef BasicBookManager<EpochHashTable<int, Book>> ConcurrentBookManager;
+
+// Manager for dense accession-number IDs; loadBooksFromCSV picks direct or
+// hashed indexing from the ID density of the file
+typedef BasicBookManager<DenseIdTable<Book>> DenseBookManager;
+
 #endif
\ No newline at end of file
@@ -2,38 +2,80 @@
 #define BORROWER_H
 
 #include "../../DataStructures/header/HashTable.h"
-#include "../../DataStructures/header/linkedList.h"
+#include "../../DataStructures/header/FlatHashTable.h"
+#include "../../DataStructures/header/HistoryLog.h"
+#include "../../DataStructures/header/LoanList.h"
 #include "../../entities/header/BorrowRecord.h"
+#include "BookManager.h"
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <iostream>
 
-class BookManager;
+// Map families for BasicBorrower. Each names a hash table template, so the
+// borrower can key maps with different value types from one choice.
+struct ChainedTables
+{
+    template <typename K, typename V>
+    using Table = HashTable<K, V>;
+};
+
+struct FlatTables
+{
+    template <typename K, typename V>
+    using Table = FlatHashTable<K, V>;
+};
 
-class Borrower
+// Tables selects the map family (ChainedTables or FlatTables); Manager is
+// the BookManager flavour used to validate titles.
+//
+// Every active loan is a single Loan record linked into its user's list and
+// its book's list and indexed by (user, title), so a return is one lookup
+// plus two O(1) unlinks however many loans the user holds.
+template <typename Tables = ChainedTables, typename Manager = BookManager>
+class BasicBorrower
 {
 private:
-    // Map userName -> list of "bookTitle|date" strings
-    HashTable<std::string, LinkedList<std::string>> *userToBooks;
+    typedef typename Tables::template Table<std::string, LoanList> ListTable;
+    typedef typename Tables::template Table<std::string, Loan *> LoanIndex;
+    typedef typename Tables::template Table<std::string, int> CountTable;
 
-    // Map bookTitle -> list of "userName|date" strings
-    HashTable<std::string, LinkedList<std::string>> *bookToUsers;
+    // Map userName -> the user's active loans
+    ListTable *userToBooks;
 
-    // Global chronological history stored as lines "userId,bookId,date,action"
-    LinkedList<std::string> *history;
+    // Map bookTitle -> the book's active loans (its current borrowers)
+    ListTable *bookToUsers;
+
+    // Map loanKey(userName, bookTitle) -> loan; owns every Loan record
+    LoanIndex *activeLoans;
+
+    // Map bookTitle -> times borrowed, over the whole history
+    CountTable *borrowCounts;
+
+    // Global chronological history of "userName,bookTitle,date,action" events
+    HistoryLog *history;
 
     // CSV file path for persistence
     std::string csvFilePath;
 
     // Pointer to BookManager for validation
-    BookManager *bookManager;
+    Manager *bookManager;
 
     // Helper to append a single CSV record
     void appendRecordToCSV(const std::string &userName, const std::string &bookTitle, const std::string &date, const std::string &action);
 
+    static std::string loanKey(std::string_view userName, std::string_view bookTitle);
+
+    // Creates a loan, links it into the index and both lists, and counts the
+    // borrow. Does nothing if the user already holds the title.
+    void openLoan(const std::string &userName, const std::string &bookTitle, const std::string &date);
+
+    // Unlinks and frees the user's loan of the title; false if there is none
+    bool closeLoan(const std::string &userName, const std::string &bookTitle);
+
 public:
-    Borrower(const std::string &borrowCsvPath = "D:/HP/Projects/DSAE/Optimized-Library-Lookup-System/data/borrow_records.csv");
-    ~Borrower();
+    BasicBorrower(const std::string &borrowCsvPath = "D:/HP/Projects/DSAE/Optimized-Library-Lookup-System/data/borrow_records.csv");
+    ~BasicBorrower();
 
     // Borrow a book (adds to maps, history and persists to CSV)
     bool borrowBook(const std::string &userName, const std::string &bookTitle, const std::string &date);
@@ -44,20 +86,44 @@ public:
     // Load all records from CSV (rebuilds in-memory maps and history)
     void loadBorrowRecordsFromCSV(const std::string &filename);
 
-    // Get pointer to a user's active borrow list (may be nullptr)
-    LinkedList<std::string> *getUserActiveBorrows(const std::string &userName);
+    // Get pointer to a user's active loans (nullptr if there are none)
+    // (string_view probes the map directly, no std::string is built)
+    const LoanList *getUserActiveBorrows(std::string_view userName);
+
+    // Get pointer to a book's active loans, i.e. its borrowers (nullptr if there are none)
+    const LoanList *getBookActiveBorrowers(std::string_view bookTitle);
+
+    // Number of books currently out on loan
+    int getActiveLoanCount() const { return activeLoans->size(); }
+
+    // Times a title has been borrowed (0 if never)
+    int getBorrowCount(std::string_view bookTitle);
 
-    // Get pointer to a book's active borrowers list (may be nullptr)
-    LinkedList<std::string> *getBookActiveBorrowers(const std::string &bookTitle);
+    // Calls visit(title, count) for every title borrowed at least once
+    template <typename Visitor>
+    void forEachBorrowCount(Visitor visit) const { borrowCounts->forEach(visit); }
 
     // Append a custom history entry (not persisted automatically)
     void addHistoryEntry(const std::string &entry);
 
-    // Access the full history list
-    LinkedList<std::string> *getHistory() { return history; }
+    // Access the full history, oldest first (rbegin() for most recent first)
+    HistoryLog *getHistory() { return history; }
 
     // Set BookManager for validation
-    void setBookManager(BookManager *manager) { bookManager = manager; }
+    void setBookManager(Manager *manager) { bookManager = manager; }
+
+    // Puts a Bloom filter in front of each map so lookups for unknown users
+    // and titles skip the bucket walk. Returns false if the table family has no filter.
+    bool enableBloomFilter(double falsePositiveRate = 0.01);
+
+    // Lookups the filters answered on their own (0 without filters)
+    long long bloomSkippedProbes() const;
 };
 
+// Default borrower used by the GUI
+typedef BasicBorrower<> Borrower;
+
+// Borrower whose maps use the open-addressing table
+typedef BasicBorrower<FlatTables, FlatBookManager> FlatBorrower;
+
 #endif
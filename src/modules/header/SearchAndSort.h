@@ -2,7 +2,8 @@
 #define SEARCH_AND_SORT_H
 
 #include "../header/BookManager.h"
-#include "../../DataStructures/header/trie.h"
+#include "../../DataStructures/header/RadixTrie.h"
+#include "../../DataStructures/header/StaticTrie.h"
 #include "../../DataStructures/header/mergeSort.h"
 #include <vector>
 #include <string>
@@ -13,22 +14,62 @@ class SearchAndSort
 {
 private:
     BookManager *bookManager;
-    Trie *autoCompleteTrie;
+    // Titles indexed by the last full load, in a compact immutable trie
+    StaticTrie *catalogTrie;
+    // Titles added since, merged into catalogTrie once it outgrows the merge threshold.
+    // A title is counted in catalogTrie if it was built in, otherwise here.
+    RadixTrie *deltaTrie;
+
+    static constexpr int DELTA_MERGE_KEYS = 4096;
+
+    // Pending delta keys or tombstones that trigger a merge
+    int mergeThreshold() const;
 
 public:
-    // Constructor and Destructor
+    // Constructor and Destructor. The manager reports every book added,
+    // renamed or deleted, so the auto-complete index follows those edits.
     SearchAndSort(BookManager *manager);
     ~SearchAndSort();
 
     // Auto-completion function using Trie
     vector<string> autoComplete(const string &prefix);
 
-    // Add book title to Trie for auto-completion
-    void addToAutoComplete(const string &title);
+    // The k completions with the highest weights (e.g. borrow counts), highest first
+    vector<string> autoComplete(const string &prefix, int k);
+
+    // Typo-tolerant completion: up to k titles starting with something
+    // within maxEdits edits of prefix, closest first, then by weight
+    vector<string> fuzzyAutoComplete(const string &prefix, int maxEdits, int k);
+
+    // autoComplete(prefix, k) with the IDs of the books behind each title,
+    // read from the index, so showing a suggestion's books takes ID lookups
+    // rather than a title scan
+    vector<pair<string, vector<int>>> autoCompleteBooks(const string &prefix, int k);
+
+    // IDs of the indexed books with this title (any case), ascending
+    vector<int> bookIdsForTitle(const string &title);
 
-    // Load all book titles from BookManager into Trie
+    // Ranks a title for autoComplete(prefix, k); ignored if the title is not indexed
+    void setTitleWeight(const string &title, uint32_t weight);
+
+    // Add book title to Trie for auto-completion (one reference per book)
+    void addToAutoComplete(const string &title, int id);
+
+    // Drops book id's reference to a title; the title stops completing
+    // once no book has it. O(title length).
+    void removeFromAutoComplete(const string &title, int id);
+
+    // Book id's title changed from oldTitle to newTitle (either may be
+    // empty, for an added or deleted book)
+    void onTitleChanged(int id, const string &oldTitle, const string &newTitle);
+
+    // Load all book titles from BookManager into Trie (rebuilds the static trie)
     void loadAllBooksToTrie();
 
+    // Folds the titles added since the last build into the static trie and
+    // drops the removed ones
+    void mergeAutoCompleteDelta();
+
     // Search function - search books by title
     vector<Book> searchBooksByTitle(const string &title);
 
@@ -3,27 +3,40 @@
 #include <cctype>
 
 // constructor
-BookManager::BookManager()
+template <typename BookTable>
+BasicBookManager<BookTable>::BasicBookManager()
 {
     // Initializing hash table for storage
-    bookTable = new HashTable<int, Book>();                                            
+    bookTable = new BookTable();                                            
     // CSV file path
     csvFilePath = "D:/HP/Projects/DSAE/Optimized-Library-Lookup-System/data/book.csv"; 
+
+    snapshot = new BookSnapshot();
+    snapshotShadow = new ShadowTable();
+    bloomFalsePositiveRate = 0;
+
+    titleIndex = new TrigramIndex();
+    titleIndexBuilt = true; // nothing to index yet
 }
 
 // destructor
-BookManager::~BookManager()
+template <typename BookTable>
+BasicBookManager<BookTable>::~BasicBookManager()
 {
     // Clean up allocated memory to avoid memory leaks
     delete bookTable;
+    delete snapshot;
+    delete snapshotShadow;
+    delete titleIndex;
 }
 
 //-----------1.ADD BOOK FUNCTION-----------
 // Adds a new book to the hash table and auto-saves to CSV
-void BookManager::addBook(int id, std::string title, std::string author, int year, std::string publisher)
+template <typename BookTable>
+void BasicBookManager<BookTable>::addBook(int id, std::string title, std::string author, int year, std::string publisher)
 {
     // Check if book's ID is unique before adding
-    if (bookTable->search(id) != nullptr)
+    if (containsBook(id))
     {
         std::cout << "Book ID already exists. Skipping add." << std::endl;
         return;
@@ -38,6 +51,11 @@ void BookManager::addBook(int id, std::string title, std::string author, int yea
 
     std::cout << "Book added successfully: " << title << std::endl;
 
+    if (titleIndexBuilt)
+        titleIndex->add(id, title);
+    if (titleObserver)
+        titleObserver(id, "", title);
+
     // Auto-save changes to CSV file
     if (!csvFilePath.empty())
     {
@@ -47,15 +65,48 @@ void BookManager::addBook(int id, std::string title, std::string author, int yea
 
 // -----------2-A. SEARCHING BOOK BY ID-----------
 //Hash table lookup by ID
-Book *BookManager::searchBook(int id)
+template <typename BookTable>
+bool BasicBookManager<BookTable>::searchBook(int id, Book &out)
 {
     // Use Hash Table's search function
-    return bookTable->search(id);    // O(1) average time complexity
+    Book *book = bookTable->search(id);    // O(1) average time complexity
+    if (!book && snapshot->isOpen())
+    {
+        // Not in the overlay: read the mapped snapshot unless the overlay
+        // owns the ID. A writer puts an edited book in the overlay before
+        // marking it owned, so an owned ID is looked up once more.
+        if (snapshotShadow->search(id))
+            book = bookTable->search(id);
+        else if (const SnapshotRecord *record = snapshot->find(id))
+        {
+            out = snapshot->toBook(*record);
+            return true;
+        }
+    }
+
+    if (!book)
+        return false;
+    out = *book;
+    return true;
 }
 
 // -----------2-B. SEARCHING BOOK BY TITLE-----------
-//linear search through all books for title match
-std::vector<Book> BookManager::searchBookByTitle(std::string title)
+// Case-insensitive substring test that compares characters in place
+// instead of building a lowercase copy of every title
+static bool containsIgnoreCase(std::string_view text, const std::string &lowerTerm)
+{
+    if (lowerTerm.empty())
+        return true;
+
+    auto it = std::search(text.begin(), text.end(), lowerTerm.begin(), lowerTerm.end(),
+                          [](char a, char b)
+                          { return (char)std::tolower((unsigned char)a) == b; });
+    return it != text.end();
+}
+
+//trigram index lookup, or a linear search through all books for short terms
+template <typename BookTable>
+std::vector<Book> BasicBookManager<BookTable>::searchBookByTitle(std::string title)
 {
     std::vector<Book> results;
 
@@ -63,41 +114,68 @@ std::vector<Book> BookManager::searchBookByTitle(std::string title)
     std::string lowerSearchTerm = title;
     std::transform(lowerSearchTerm.begin(), lowerSearchTerm.end(), lowerSearchTerm.begin(), ::tolower);
 
-    // Get all books from hash table to iterate through
-    auto allBooks = getAllBooks();
+    if (!titleIndexBuilt)
+        rebuildTitleIndex();
 
-    // Search through all books for matching title
-    for (const auto &entry : allBooks)
+    // Candidates have every trigram of the term; confirm each against its
+    // title. Lookups are read-only, so snapshot books stay out of the overlay.
+    std::vector<int> candidates;
+    if (titleIndex->candidates(lowerSearchTerm, candidates))
     {
-        const Book &book = entry.second;
-        // Convert current book title to lowercase
-        std::string lowerTitle = book.getTitle();
-        std::transform(lowerTitle.begin(), lowerTitle.end(), lowerTitle.begin(), ::tolower);
-
-        // Check if the search term is found in the title
-        if (lowerTitle.find(lowerSearchTerm) != std::string::npos)
+        for (int id : candidates)
         {
-            results.push_back(book);
+            if (Book *book = bookTable->search(id))
+            {
+                if (containsIgnoreCase(book->getTitle(), lowerSearchTerm))
+                    results.push_back(*book);
+            }
+            else if (snapshot->isOpen() && !snapshotShadow->search(id))
+            {
+                const SnapshotRecord *record = snapshot->find(id);
+                if (record && containsIgnoreCase(snapshot->title(*record), lowerSearchTerm))
+                    results.push_back(snapshot->toBook(*record));
+            }
         }
+        return results;
     }
 
+    // Too short for a trigram: walk the hash table in place; only matching books are copied out
+    forEachBook([&](const Book &book)
+                {
+                    if (containsIgnoreCase(book.getTitle(), lowerSearchTerm))
+                        results.push_back(book);
+                });
+
+    // The scan visits books in table order; sort to match the index path
+    std::sort(results.begin(), results.end(), [](const Book &a, const Book &b)
+              { return a.getId() < b.getId(); });
     return results;
 }
 
 //-----------3. DELETE FUNCTION-----------
 // Deletes a book by ID and updates CSV
-bool BookManager::deleteBook(int id)
+template <typename BookTable>
+bool BasicBookManager<BookTable>::deleteBook(int id)
 {
-    // Check if book exists
-    if (bookTable->search(id) == nullptr)
+    // Check if book exists; the index and the observer need the title that is going away
+    Book existing;
+    if (!searchBook(id, existing))
     {
         std::cout << "Book not found!" << std::endl;
         return false;
     }
-    // Remove book from hash table
+    std::string oldTitle = existing.getTitle();
+
+    // Remove book from hash table; a snapshot copy is hidden, not erased
     bookTable->remove(id);
+    shadowSnapshotBook(id);
     std::cout << "Book deleted successfully." << std::endl;
 
+    if (titleIndexBuilt)
+        titleIndex->remove(id, oldTitle);
+    if (titleObserver)
+        titleObserver(id, oldTitle, "");
+
     // Update CSV file after deletion
     if (!csvFilePath.empty())
     {
@@ -109,18 +187,36 @@ bool BookManager::deleteBook(int id)
 
 //---------- 4. UPDATE FUNCTION-----------
 // Updates book details and auto-saves to CSV
-bool BookManager::updateBook(int id, std::string newTitle, std::string newAuthor, int newYear)
+template <typename BookTable>
+bool BasicBookManager<BookTable>::updateBook(int id, std::string newTitle, std::string newAuthor, int newYear)
 {
-    Book *book = bookTable->search(id);
+    Book updated;
     // Check if book exists
-    if (book != nullptr)
+    if (searchBook(id, updated))
     {
-        // Update the fields of the book
-        book->setTitle(newTitle);
-        book->setAuthor(newAuthor);
-        book->setYear(newYear);
+        // Update the fields on a copy and store it back, so tables with
+        // lock-free readers can swap the record in atomically
+        std::string oldTitle = updated.getTitle();
+        updated.setTitle(newTitle);
+        updated.setAuthor(newAuthor);
+        updated.setYear(newYear);
+        if (!bookTable->update(id, updated))
+        {
+            // Copy-on-write: the edited snapshot book moves into the
+            // overlay first, then the overlay takes the ID over
+            bookTable->insert(id, updated);
+            shadowSnapshotBook(id);
+        }
         std::cout << "Book updated successfully." << std::endl;
 
+        if (titleIndexBuilt && oldTitle != newTitle)
+        {
+            titleIndex->remove(id, oldTitle);
+            titleIndex->add(id, newTitle);
+        }
+        if (titleObserver)
+            titleObserver(id, oldTitle, newTitle);
+
         // Save changes to CSV file
         if (!csvFilePath.empty())
         {
@@ -138,7 +234,8 @@ bool BookManager::updateBook(int id, std::string newTitle, std::string newAuthor
 
 //---------- 5. LOAD BOOKS FROM CSV FUNCTION-----------
 // Loads books from a CSV file into the hash table
-void BookManager::loadBooksFromCSV(std::string filename)
+template <typename BookTable>
+void BasicBookManager<BookTable>::loadBooksFromCSV(std::string filename)
 {
     csvFilePath = filename;
     std::ifstream file(filename);
@@ -153,6 +250,10 @@ void BookManager::loadBooksFromCSV(std::string filename)
     // Skip header line
     // std::getline(file, line);
 
+    // Rows are parsed into one batch and handed to the table in a single
+    // bulkLoad, which sizes it once; a repeated ID keeps its last row
+    std::vector<std::pair<int, Book>> rows;
+
     while (std::getline(file, line))
     {
         try
@@ -189,9 +290,7 @@ void BookManager::loadBooksFromCSV(std::string filename)
             if (!std::getline(ss, publisher, ','))
                 publisher = "Unknown";
 
-            // Add book to the hash table
-            Book newBook(id, title, author, year, publisher);
-            bookTable->insert(id, newBook);
+            rows.emplace_back(id, Book(id, title, author, year, publisher));
         }
         catch (const std::exception &e)
         {
@@ -202,12 +301,29 @@ void BookManager::loadBooksFromCSV(std::string filename)
     }
 
     file.close();
+
+    // Rows for snapshot books replace them in the overlay
+    if (snapshot->isOpen())
+    {
+        for (const std::pair<int, Book> &row : rows)
+            shadowSnapshotBook(row.first);
+    }
+
+    size_t rowCount = rows.size();
+    int added = bookTable->bulkLoad(std::move(rows), DuplicatePolicy::KeepLast);
+    if ((size_t)added < rowCount)
+        std::cerr << "Warning: " << rowCount - added << " rows repeated an existing book ID; the last one was kept" << std::endl;
+
+    // Rows may have replaced books, so index the titles afresh
+    rebuildTitleIndex();
+
     std::cout << "Data loaded successfully from " << filename << std::endl;
 }
 
 //---------6. SAVE BOOKS TO CSV FUNCTION-----------
 // Saves all books from the hash table to a CSV file
-void BookManager::saveBooksToCSV(std::string filename)
+template <typename BookTable>
+void BasicBookManager<BookTable>::saveBooksToCSV(std::string filename)
 {
     std::ofstream file(filename);
 
@@ -220,26 +336,134 @@ void BookManager::saveBooksToCSV(std::string filename)
     // Write header
     file << "ID,Title,Author,Year,Publisher" << std::endl;
 
-    // Get all books from the hash table
-    auto entries = bookTable->getAllEntries();
-
-    // loop through all books and write each book to CSV
-    for (const auto &entry : entries)
-    {
-        const Book &book = entry.second;
-        file << book.getId() << ","
-             << book.getTitle() << ","
-             << book.getAuthor() << ","
-             << book.getYear() << ","
-             << book.getPublisher() << std::endl;
-    }
+    // Write each book straight from the hash table
+    forEachBook([&](const Book &book)
+                {
+                    file << book.getId() << ","
+                         << book.getTitle() << ","
+                         << book.getAuthor() << ","
+                         << book.getYear() << ","
+                         << book.getPublisher() << std::endl;
+                });
 
     file.close();
     std::cout << "Data saved successfully to " << filename << std::endl;
 }
 
 //----------7. GET ALL BOOKS FUNCTION-----------
-std::vector<std::pair<int, Book>> BookManager::getAllBooks()
+template <typename BookTable>
+std::vector<std::pair<int, Book>> BasicBookManager<BookTable>::getAllBooks()
+{
+    if (!snapshot->isOpen())
+        return bookTable->getAllEntries();
+
+    std::vector<std::pair<int, Book>> books;
+    books.reserve(getBookCount());
+    forEachBook([&](const Book &book)
+                { books.emplace_back(book.getId(), book); });
+    return books;
+}
+
+//----------8. MISS FILTER-----------
+template <typename BookTable>
+bool BasicBookManager<BookTable>::enableBloomFilter(double falsePositiveRate)
+{
+    if constexpr (SupportsBloomFilter<BookTable>::value)
+    {
+        bookTable->enableBloomFilter(falsePositiveRate);
+        bloomFalsePositiveRate = falsePositiveRate; // reapplied when openSnapshot() replaces the table
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <typename BookTable>
+long long BasicBookManager<BookTable>::bloomSkippedProbes() const
+{
+    if constexpr (SupportsBloomFilter<BookTable>::value)
+        return bookTable->bloomSkippedProbes();
+    else
+        return 0;
+}
+
+//----------9. SNAPSHOTS-----------
+template <typename BookTable>
+bool BasicBookManager<BookTable>::containsBook(int id)
+{
+    if (bookTable->search(id) != nullptr)
+        return true;
+    return snapshot->isOpen() && !snapshotShadow->search(id) && snapshot->find(id) != nullptr;
+}
+
+template <typename BookTable>
+void BasicBookManager<BookTable>::shadowSnapshotBook(int id)
+{
+    if (snapshot->isOpen() && !snapshotShadow->search(id) && snapshot->find(id))
+        snapshotShadow->insert(id, 1);
+}
+
+template <typename BookTable>
+void BasicBookManager<BookTable>::rebuildTitleIndex()
+{
+    titleIndex->clear();
+    forEachBook([&](const Book &book)
+                { titleIndex->add(book.getId(), book.getTitle()); });
+    titleIndexBuilt = true;
+}
+
+template <typename BookTable>
+bool BasicBookManager<BookTable>::saveSnapshot(std::string filename)
 {
-    return bookTable->getAllEntries();
-}
\ No newline at end of file
+    BookSnapshotWriter writer;
+    forEachBook([&](const Book &book)
+                { writer.add(book); });
+
+    if (!writer.write(filename))
+    {
+        std::cerr << "Error: Could not write snapshot " << filename << std::endl;
+        return false;
+    }
+
+    std::cout << "Snapshot saved: " << writer.size() << " books to " << filename << std::endl;
+    return true;
+}
+
+template <typename BookTable>
+bool BasicBookManager<BookTable>::openSnapshot(std::string filename, bool verifyChecksum)
+{
+    BookSnapshot *opened = new BookSnapshot();
+    if (!opened->open(filename, verifyChecksum))
+    {
+        std::cerr << "Error: " << filename << " is missing or not a valid snapshot" << std::endl;
+        delete opened;
+        return false;
+    }
+
+    // The snapshot becomes the catalog; start an empty overlay over it
+    delete snapshot;
+    snapshot = opened;
+    delete bookTable;
+    bookTable = new BookTable();
+    delete snapshotShadow;
+    snapshotShadow = new ShadowTable();
+
+    if (bloomFalsePositiveRate > 0)
+        enableBloomFilter(bloomFalsePositiveRate);
+
+    titleIndex->clear();
+    titleIndexBuilt = false;
+
+    std::cout << "Snapshot opened: " << snapshot->size() << " books from " << filename << std::endl;
+    return true;
+}
+
+// -----------------------
+// Explicit template instantiation
+// -----------------------
+template class BasicBookManager<HashTable<int, Book>>;
+template class BasicBookManager<FlatHashTable<int, Book>>;
+template class BasicBookManager<EpochHashTable<int, Book>>;
+template class BasicBookManager<DenseIdTable<Book>>;
@@ -1,15 +1,18 @@
 #include "../../DataStructures/header/HashTable.h"
-#include "../../DataStructures/header/linkedList.h"
+#include "../../DataStructures/header/LoanList.h"
 #include "../header/Borrower.h"
 #include "../header/BookManager.h"
 #include <sstream>
 #include <ctime>
 
-Borrower::Borrower(const std::string &borrowCsvPath)
+template <typename Tables, typename Manager>
+BasicBorrower<Tables, Manager>::BasicBorrower(const std::string &borrowCsvPath)
 {
-    userToBooks = new HashTable<std::string, LinkedList<std::string>>();
-    bookToUsers = new HashTable<std::string, LinkedList<std::string>>();
-    history = new LinkedList<std::string>();
+    userToBooks = new ListTable();
+    bookToUsers = new ListTable();
+    activeLoans = new LoanIndex();
+    borrowCounts = new CountTable();
+    history = new HistoryLog();
     csvFilePath = borrowCsvPath;
     bookManager = nullptr;
 
@@ -17,15 +20,22 @@ Borrower::Borrower(const std::string &borrowCsvPath)
     loadBorrowRecordsFromCSV(csvFilePath);
 }
 
-Borrower::~Borrower()
+template <typename Tables, typename Manager>
+BasicBorrower<Tables, Manager>::~BasicBorrower()
 {
     // We don't attempt to write a full rewrite here; records are appended on every operation.
+    // The index owns the loans; the lists only link them.
+    activeLoans->forEach([](const std::string &, Loan *const &loan)
+                         { delete loan; });
+    delete activeLoans;
+    delete borrowCounts;
     delete userToBooks;
     delete bookToUsers;
     delete history;
 }
 
-void Borrower::appendRecordToCSV(const std::string &userName, const std::string &bookTitle, const std::string &date, const std::string &action)
+template <typename Tables, typename Manager>
+void BasicBorrower<Tables, Manager>::appendRecordToCSV(const std::string &userName, const std::string &bookTitle, const std::string &date, const std::string &action)
 {
     std::ofstream out(csvFilePath, std::ios::app);
     if (!out.is_open())
@@ -38,7 +48,65 @@ void Borrower::appendRecordToCSV(const std::string &userName, const std::string
     out.close();
 }
 
-bool Borrower::borrowBook(const std::string &userName, const std::string &bookTitle, const std::string &date)
+// Unit separator: cannot appear in a user name or title read from the CSV
+template <typename Tables, typename Manager>
+std::string BasicBorrower<Tables, Manager>::loanKey(std::string_view userName, std::string_view bookTitle)
+{
+    std::string key;
+    key.reserve(userName.size() + bookTitle.size() + 1);
+    key.append(userName).append(1, '\x1f').append(bookTitle);
+    return key;
+}
+
+template <typename Tables, typename Manager>
+void BasicBorrower<Tables, Manager>::openLoan(const std::string &userName, const std::string &bookTitle, const std::string &date)
+{
+    // insert() on a chained table appends even for a known key, so claim
+    // the index slot first; if the user already holds this title (a
+    // repeated borrow row), keep the existing loan and count nothing
+    std::pair<Loan **, bool> slot = activeLoans->try_emplace(loanKey(userName, bookTitle), nullptr);
+    if (!slot.second)
+        return;
+
+    Loan *loan = new Loan(userName, bookTitle, date);
+    *slot.first = loan;
+
+    // A first loan builds the empty list in place in the table
+    userToBooks->try_emplace(userName, BY_USER).first->pushBack(loan);
+    bookToUsers->try_emplace(bookTitle, BY_BOOK).first->pushBack(loan);
+
+    (*borrowCounts->try_emplace(bookTitle, 0).first)++;
+}
+
+template <typename Tables, typename Manager>
+bool BasicBorrower<Tables, Manager>::closeLoan(const std::string &userName, const std::string &bookTitle)
+{
+    std::string key = loanKey(userName, bookTitle);
+    Loan **found = activeLoans->search(key);
+    if (!found)
+        return false;
+
+    Loan *loan = *found;
+    activeLoans->remove(key);
+
+    // Both lists exist while the loan does; drop a list once it empties so
+    // the maps only hold users and books with something out
+    LoanList *uList = userToBooks->search(userName);
+    uList->unlink(loan);
+    if (uList->empty())
+        userToBooks->remove(userName);
+
+    LoanList *bList = bookToUsers->search(bookTitle);
+    bList->unlink(loan);
+    if (bList->empty())
+        bookToUsers->remove(bookTitle);
+
+    delete loan;
+    return true;
+}
+
+template <typename Tables, typename Manager>
+bool BasicBorrower<Tables, Manager>::borrowBook(const std::string &userName, const std::string &bookTitle, const std::string &date)
 {
     // Validate that book exists in BookManager
     if (bookManager)
@@ -52,75 +120,24 @@ bool Borrower::borrowBook(const std::string &userName, const std::string &bookTi
     }
 
     // Check if book is already borrowed by anyone
-    LinkedList<std::string> *bookBorrowers = bookToUsers->search(bookTitle);
-    if (bookBorrowers)
+    const LoanList *bookBorrowers = bookToUsers->search(bookTitle);
+    if (bookBorrowers && !bookBorrowers->empty())
     {
-        auto borrowers = bookBorrowers->toVector();
-        if (!borrowers.empty())
-        {
-            // Extract the borrower's name from first entry (format: "userName|date")
-            std::string firstEntry = borrowers[0];
-            size_t pipePos = firstEntry.find('|');
-            std::string currentBorrower = (pipePos != std::string::npos) ? firstEntry.substr(0, pipePos) : firstEntry;
-            std::cerr << "Error: Book '" << bookTitle << "' is already borrowed by '" << currentBorrower << "'!" << std::endl;
-            return false;
-        }
+        std::cerr << "Error: Book '" << bookTitle << "' is already borrowed by '" << bookBorrowers->front().user << "'!" << std::endl;
+        return false;
     }
 
     // Check if user already has this book borrowed
-    LinkedList<std::string> *userBorrows = userToBooks->search(userName);
-    if (userBorrows)
+    if (activeLoans->search(loanKey(userName, bookTitle)))
     {
-        // Check if any entry starts with the bookTitle
-        for (const auto &entry : userBorrows->toVector())
-        {
-            // Entry format: "bookTitle|date"
-            size_t pipePos = entry.find('|');
-            if (pipePos != std::string::npos)
-            {
-                std::string existingBook = entry.substr(0, pipePos);
-                if (existingBook == bookTitle)
-                {
-                    std::cerr << "Error: User '" << userName << "' has already borrowed '" << bookTitle << "'!" << std::endl;
-                    return false;
-                }
-            }
-        }
-    }
-
-    // Create formatted strings for the different lists
-    std::string userEntry = bookTitle + "|" + date; // stored in user->books
-    std::string bookEntry = userName + "|" + date;  // stored in book->users
-    std::string hist = userName + "," + bookTitle + "," + date + ",borrow";
-
-    // Update userToBooks
-    LinkedList<std::string> *uList = userToBooks->search(userName);
-    if (uList)
-    {
-        uList->insertAtEnd(userEntry);
-    }
-    else
-    {
-        LinkedList<std::string> newList;
-        newList.insertAtEnd(userEntry);
-        userToBooks->insert(userName, newList);
+        std::cerr << "Error: User '" << userName << "' has already borrowed '" << bookTitle << "'!" << std::endl;
+        return false;
     }
 
-    // Update bookToUsers
-    LinkedList<std::string> *bList = bookToUsers->search(bookTitle);
-    if (bList)
-    {
-        bList->insertAtEnd(bookEntry);
-    }
-    else
-    {
-        LinkedList<std::string> newList;
-        newList.insertAtEnd(bookEntry);
-        bookToUsers->insert(bookTitle, newList);
-    }
+    openLoan(userName, bookTitle, date);
 
     // Add to in-memory history
-    history->insertAtEnd(hist);
+    history->append(userName, bookTitle, date, "borrow");
 
     // Persist by appending to CSV
     appendRecordToCSV(userName, bookTitle, date, "borrow");
@@ -129,115 +146,18 @@ bool Borrower::borrowBook(const std::string &userName, const std::string &bookTi
     return true;
 }
 
-bool Borrower::returnBook(const std::string &userName, const std::string &bookTitle, const std::string &date)
+template <typename Tables, typename Manager>
+bool BasicBorrower<Tables, Manager>::returnBook(const std::string &userName, const std::string &bookTitle, const std::string &date)
 {
-    // Construct formatted entries to remove
-    std::string userEntry = bookTitle + "|" + date; // exact-date removal attempt
-
-    // Because the return date may differ from borrow date, we'll try to remove any entry with bookId for the user
-    LinkedList<std::string> *uList = userToBooks->search(userName);
-    bool removedFromUser = false;
-    if (uList)
-    {
-        // We need to search the list for an entry that starts with bookId
-        // Since LinkedList only provides search/remove by equality, we'll attempt to remove by building possible entries.
-        // Strategy: iterate common date formats by looking through CSV-backed history to find matching borrow for this user/book.
-        // Fallback: try to remove any exact match with provided date; if not found, do a best-effort scan of history for most recent borrow.
-
-        // Try exact date removal first
-        removedFromUser = uList->remove(userEntry);
-
-        if (!removedFromUser)
-        {
-            // Scan history (we appended all borrows/returns) backwards would be ideal, but LinkedList has no iterator.
-            // We'll do a best-effort: attempt to remove any entry with prefix "bookId|" by trying to reconstruct possible entries from CSV file.
-            std::ifstream in(csvFilePath);
-            if (in.is_open())
-            {
-                std::string line;
-                std::string foundDate;
-                while (std::getline(in, line))
-                {
-                    std::stringstream ss(line);
-                    std::string uStr, bStr, dStr, act;
-                    if (!std::getline(ss, uStr, ','))
-                        continue;
-                    if (!std::getline(ss, bStr, ','))
-                        continue;
-                    if (!std::getline(ss, dStr, ','))
-                        continue;
-                    if (!std::getline(ss, act, ','))
-                        continue;
-
-                    if (uStr == userName && bStr == bookTitle && act == "borrow")
-                    {
-                        foundDate = dStr;
-                        // Try to remove that specific borrow entry
-                        std::string candidate = bookTitle + "|" + foundDate;
-                        if (uList->remove(candidate))
-                        {
-                            removedFromUser = true;
-                            break;
-                        }
-                    }
-                }
-                in.close();
-            }
-        }
-    }
-
-    // Remove from bookToUsers similarly
-    LinkedList<std::string> *bList = bookToUsers->search(bookTitle);
-    bool removedFromBook = false;
-    if (bList)
-    {
-        // try exact date remove
-        std::string exact = userName + "|" + date;
-        removedFromBook = bList->remove(exact);
-
-        if (!removedFromBook)
-        {
-            // attempt to find borrow date from CSV
-            std::ifstream in(csvFilePath);
-            if (in.is_open())
-            {
-                std::string line;
-                std::string foundDate;
-                while (std::getline(in, line))
-                {
-                    std::stringstream ss(line);
-                    std::string uStr, bStr, dStr, act;
-                    if (!std::getline(ss, uStr, ','))
-                        continue;
-                    if (!std::getline(ss, bStr, ','))
-                        continue;
-                    if (!std::getline(ss, dStr, ','))
-                        continue;
-                    if (!std::getline(ss, act, ','))
-                        continue;
-
-                    if (uStr == userName && bStr == bookTitle && act == "borrow")
-                    {
-                        foundDate = dStr;
-                        std::string candidate = userName + "|" + foundDate;
-                        if (bList->remove(candidate))
-                        {
-                            removedFromBook = true;
-                            break;
-                        }
-                    }
-                }
-                in.close();
-            }
-        }
-    }
+    // The loan is found by (user, title): the return date usually differs
+    // from the borrow date, and no list is scanned however long it is
+    bool closed = closeLoan(userName, bookTitle);
 
     // Record return in history and CSV regardless of whether removal succeeded (best-effort)
-    std::string hist = userName + "," + bookTitle + "," + date + ",return";
-    history->insertAtEnd(hist);
+    history->append(userName, bookTitle, date, "return");
     appendRecordToCSV(userName, bookTitle, date, "return");
 
-    if (removedFromUser || removedFromBook)
+    if (closed)
     {
         std::cout << "Return processed: user '" << userName << "' returned book '" << bookTitle << "' on " << date << std::endl;
         return true;
@@ -247,7 +167,8 @@ bool Borrower::returnBook(const std::string &userName, const std::string &bookTi
     return false;
 }
 
-void Borrower::loadBorrowRecordsFromCSV(const std::string &filename)
+template <typename Tables, typename Manager>
+void BasicBorrower<Tables, Manager>::loadBorrowRecordsFromCSV(const std::string &filename)
 {
     std::ifstream in(filename);
     if (!in.is_open())
@@ -274,61 +195,69 @@ void Borrower::loadBorrowRecordsFromCSV(const std::string &filename)
             continue;
 
         // Append to history
-        history->insertAtEnd(userName + "," + bookTitle + "," + date + "," + action);
+        history->append(userName, bookTitle, date, action);
 
         if (action == "borrow")
-        {
-            // user -> books
-            if (auto uList = userToBooks->search(userName))
-            {
-                uList->insertAtEnd(bookTitle + "|" + date);
-            }
-            else
-            {
-                LinkedList<std::string> newList;
-                newList.insertAtEnd(bookTitle + "|" + date);
-                userToBooks->insert(userName, newList);
-            }
-
-            // book -> users
-            if (auto bList = bookToUsers->search(bookTitle))
-            {
-                bList->insertAtEnd(userName + "|" + date);
-            }
-            else
-            {
-                LinkedList<std::string> newList;
-                newList.insertAtEnd(userName + "|" + date);
-                bookToUsers->insert(bookTitle, newList);
-            }
-        }
+            openLoan(userName, bookTitle, date);
         else if (action == "return")
-        {
-            if (auto uList = userToBooks->search(userName))
-            {
-                uList->remove(bookTitle + "|" + date);
-            }
-            if (auto bList = bookToUsers->search(bookTitle))
-            {
-                bList->remove(userName + "|" + date);
-            }
-        }
+            closeLoan(userName, bookTitle);
     }
 
     in.close();
 }
 
-LinkedList<std::string> *Borrower::getUserActiveBorrows(const std::string &userName)
+template <typename Tables, typename Manager>
+const LoanList *BasicBorrower<Tables, Manager>::getUserActiveBorrows(std::string_view userName)
 {
     return userToBooks->search(userName);
 }
 
-LinkedList<std::string> *Borrower::getBookActiveBorrowers(const std::string &bookTitle)
+template <typename Tables, typename Manager>
+const LoanList *BasicBorrower<Tables, Manager>::getBookActiveBorrowers(std::string_view bookTitle)
 {
     return bookToUsers->search(bookTitle);
 }
 
-void Borrower::addHistoryEntry(const std::string &entry)
+template <typename Tables, typename Manager>
+int BasicBorrower<Tables, Manager>::getBorrowCount(std::string_view bookTitle)
+{
+    int *count = borrowCounts->search(bookTitle);
+    return count ? *count : 0;
+}
+
+template <typename Tables, typename Manager>
+void BasicBorrower<Tables, Manager>::addHistoryEntry(const std::string &entry)
+{
+    history->appendNote(entry);
+}
+
+template <typename Tables, typename Manager>
+bool BasicBorrower<Tables, Manager>::enableBloomFilter(double falsePositiveRate)
+{
+    if constexpr (SupportsBloomFilter<ListTable>::value)
+    {
+        userToBooks->enableBloomFilter(falsePositiveRate);
+        bookToUsers->enableBloomFilter(falsePositiveRate);
+        activeLoans->enableBloomFilter(falsePositiveRate);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <typename Tables, typename Manager>
+long long BasicBorrower<Tables, Manager>::bloomSkippedProbes() const
 {
-    history->insertAtEnd(entry);
+    if constexpr (SupportsBloomFilter<ListTable>::value)
+        return userToBooks->bloomSkippedProbes() + bookToUsers->bloomSkippedProbes() + activeLoans->bloomSkippedProbes();
+    else
+        return 0;
 }
+
+// -----------------------
+// Explicit template instantiation
+// -----------------------
+template class BasicBorrower<ChainedTables, BookManager>;
+template class BasicBorrower<FlatTables, FlatBookManager>;
@@ -5,6 +5,7 @@
 #include <cctype>
 #include <sstream>
 #include <functional>
+#include <iterator>
 
 // Wrapper structure for sorting Book pointers by title
 struct BookTitleWrapper
@@ -45,13 +46,19 @@ struct BookAuthorWrapper
 // Constructor
 SearchAndSort::SearchAndSort(BookManager *manager) : bookManager(manager)
 {
-    autoCompleteTrie = new Trie();
+    catalogTrie = new StaticTrie();
+    deltaTrie = new RadixTrie();
+
+    bookManager->setTitleObserver([this](int id, const string &oldTitle, const string &newTitle)
+                                  { onTitleChanged(id, oldTitle, newTitle); });
 }
 
 // Destructor
 SearchAndSort::~SearchAndSort()
 {
-    delete autoCompleteTrie;
+    bookManager->setTitleObserver(nullptr);
+    delete catalogTrie;
+    delete deltaTrie;
 }
 
 // Auto-completion function using Trie
@@ -62,66 +69,250 @@ vector<string> SearchAndSort::autoComplete(const string &prefix)
         return vector<string>();
     }
 
-    return autoCompleteTrie->getAutoComplete(prefix);
+    vector<string> catalogResults = catalogTrie->getAutoComplete(prefix);
+    if (deltaTrie->size() == 0)
+        return catalogResults;
+
+    // Both lists are sorted and share the typed prefix; a title in both appears once
+    vector<string> deltaResults = deltaTrie->getAutoComplete(prefix);
+    vector<string> results;
+    results.reserve(catalogResults.size() + deltaResults.size());
+    set_union(catalogResults.begin(), catalogResults.end(), deltaResults.begin(), deltaResults.end(),
+              back_inserter(results));
+    return results;
 }
 
-// Add book title to Trie for auto-completion
-void SearchAndSort::addToAutoComplete(const string &title)
+vector<string> SearchAndSort::autoComplete(const string &prefix, int k)
 {
-    if (!title.empty())
+    if (prefix.empty() || k <= 0)
     {
-        autoCompleteTrie->insert(title);
+        return vector<string>();
     }
+
+    // The best k overall are among the best k of each trie
+    vector<pair<uint32_t, string>> ranked;
+    for (string &title : catalogTrie->getAutoComplete(prefix, k))
+        ranked.emplace_back(catalogTrie->weightOf(title), std::move(title));
+    for (string &title : deltaTrie->getAutoComplete(prefix, k))
+        ranked.emplace_back(deltaTrie->weightOf(title), std::move(title));
+
+    // Highest weight first, then by title; a title in both tries keeps its higher weight
+    sort(ranked.begin(), ranked.end(), [](const pair<uint32_t, string> &a, const pair<uint32_t, string> &b)
+         { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+
+    vector<string> results;
+    for (pair<uint32_t, string> &entry : ranked)
+    {
+        if ((int)results.size() == k)
+            break;
+        if (find(results.begin(), results.end(), entry.second) == results.end())
+            results.push_back(std::move(entry.second));
+    }
+    return results;
 }
 
-// Load all book titles from BookManager into Trie
-void SearchAndSort::loadAllBooksToTrie()
+// Smallest edit distance between query and a prefix of title (both lowercase)
+static int prefixEditDistance(const string &query, const string &title)
 {
-    // Get all books from BookManager
-    auto allBooks = bookManager->getAllBooks();
+    vector<int> row(query.size() + 1), next(query.size() + 1);
+    for (size_t j = 0; j <= query.size(); j++)
+        row[j] = (int)j;
+    int best = row[query.size()];
+    for (char c : title)
+    {
+        next[0] = row[0] + 1;
+        for (size_t j = 1; j <= query.size(); j++)
+            next[j] = min(row[j - 1] + (query[j - 1] != c), min(row[j], next[j - 1]) + 1);
+        row.swap(next);
+        best = min(best, row[query.size()]);
+    }
+    return best;
+}
 
-    // Add each book title to the Trie
-    for (const auto &entry : allBooks)
+vector<string> SearchAndSort::fuzzyAutoComplete(const string &prefix, int maxEdits, int k)
+{
+    if (prefix.empty() || k <= 0)
     {
-        const Book &book = entry.second;
-        addToAutoComplete(book.getTitle());
+        return vector<string>();
     }
 
-    cout << "Loaded " << allBooks.size() << " book titles into auto-complete." << endl;
+    // The tries' key bytes: lowercase ASCII only
+    string query;
+    for (char c : prefix)
+        if ((unsigned char)c < 128)
+            query.push_back((char)tolower(c));
+
+    // As autoComplete(prefix, k), ranked by distance before weight
+    struct Match
+    {
+        int distance;
+        uint32_t weight;
+        string title;
+    };
+    vector<Match> ranked;
+    for (string &title : catalogTrie->getFuzzyAutoComplete(prefix, maxEdits, k))
+        ranked.push_back(Match{prefixEditDistance(query, title), catalogTrie->weightOf(title), std::move(title)});
+    for (string &title : deltaTrie->getFuzzyAutoComplete(prefix, maxEdits, k))
+        ranked.push_back(Match{prefixEditDistance(query, title), deltaTrie->weightOf(title), std::move(title)});
+
+    sort(ranked.begin(), ranked.end(), [](const Match &a, const Match &b)
+         {
+             if (a.distance != b.distance)
+                 return a.distance < b.distance;
+             return a.weight != b.weight ? a.weight > b.weight : a.title < b.title; });
+
+    vector<string> results;
+    for (Match &match : ranked)
+    {
+        if ((int)results.size() == k)
+            break;
+        if (find(results.begin(), results.end(), match.title) == results.end())
+            results.push_back(std::move(match.title));
+    }
+    return results;
 }
 
-// Search function - search books by partial title match
-vector<Book> SearchAndSort::searchBooksByTitle(const string &searchTerm)
+vector<pair<string, vector<int>>> SearchAndSort::autoCompleteBooks(const string &prefix, int k)
 {
-    vector<Book> results;
-
-    if (searchTerm.empty())
+    vector<pair<string, vector<int>>> results;
+    for (string &title : autoComplete(prefix, k))
     {
-        return results;
+        vector<int> ids = bookIdsForTitle(title);
+        results.emplace_back(std::move(title), std::move(ids));
     }
+    return results;
+}
 
-    // Get all books from BookManager
-    auto allBooks = bookManager->getAllBooks();
+vector<int> SearchAndSort::bookIdsForTitle(const string &title)
+{
+    // A title's books can be split between the tries (see addToAutoComplete)
+    vector<int> ids = catalogTrie->idsOf(title);
+    vector<int> deltaIds = deltaTrie->idsOf(title);
+    ids.insert(ids.end(), deltaIds.begin(), deltaIds.end());
+    sort(ids.begin(), ids.end());
+    return ids;
+}
 
-    // Convert search term to lowercase for case-insensitive search
-    string lowerSearchTerm = searchTerm;
-    transform(lowerSearchTerm.begin(), lowerSearchTerm.end(), lowerSearchTerm.begin(), ::tolower);
+void SearchAndSort::setTitleWeight(const string &title, uint32_t weight)
+{
+    catalogTrie->setWeight(title, weight);
+    deltaTrie->setWeight(title, weight);
+}
 
-    // Search through all books for title matches
-    for (const auto &entry : allBooks)
+// Add book title to Trie for auto-completion
+void SearchAndSort::addToAutoComplete(const string &title, int id)
+{
+    if (!title.empty())
     {
-        const Book &book = entry.second;
-        string lowerTitle = book.getTitle();
-        transform(lowerTitle.begin(), lowerTitle.end(), lowerTitle.begin(), ::tolower);
+        // A title the static trie was built with (even one since removed)
+        // just gains a reference there, while it has a free ID slot; any
+        // more books with it go to the delta
+        if (catalogTrie->addRef(title, id))
+            return;
+        deltaTrie->insert(title, id);
+
+        if (deltaTrie->size() >= mergeThreshold())
+            mergeAutoCompleteDelta();
+    }
+}
+
+void SearchAndSort::removeFromAutoComplete(const string &title, int id)
+{
+    if (title.empty())
+        return;
 
-        // Check if the search term is found in the title
-        if (lowerTitle.find(lowerSearchTerm) != string::npos)
+    if (!catalogTrie->remove(title, id))
+        deltaTrie->remove(title, id);
+    else if (catalogTrie->tombstones() >= mergeThreshold())
+        mergeAutoCompleteDelta();
+}
+
+void SearchAndSort::onTitleChanged(int id, const string &oldTitle, const string &newTitle)
+{
+    if (oldTitle == newTitle)
+        return;
+    removeFromAutoComplete(oldTitle, id);
+    addToAutoComplete(newTitle, id);
+}
+
+// Merging rebuilds the whole static trie, so let the delta (and the
+// tombstones) grow with the catalog to keep the rebuild cost per edit constant
+int SearchAndSort::mergeThreshold() const
+{
+    return max(DELTA_MERGE_KEYS, catalogTrie->size() / 8);
+}
+
+void SearchAndSort::mergeAutoCompleteDelta()
+{
+    if (deltaTrie->size() == 0 && catalogTrie->tombstones() == 0)
+        return;
+
+    // Live titles only, once per book; weights carry over
+    vector<string> titles;
+    vector<uint32_t> weights;
+    vector<int> ids;
+    for (const string &title : catalogTrie->getAutoComplete(""))
+    {
+        uint32_t weight = catalogTrie->weightOf(title);
+        for (int id : catalogTrie->idsOf(title))
         {
-            results.push_back(book);
+            titles.push_back(title);
+            weights.push_back(weight);
+            ids.push_back(id);
         }
     }
+    for (const string &title : deltaTrie->getAutoComplete(""))
+    {
+        uint32_t weight = deltaTrie->weightOf(title);
+        for (int id : deltaTrie->idsOf(title))
+        {
+            titles.push_back(title);
+            weights.push_back(weight);
+            ids.push_back(id);
+        }
+    }
+    catalogTrie->build(titles, weights, ids);
 
-    return results;
+    delete deltaTrie;
+    deltaTrie = new RadixTrie();
+}
+
+// Load all book titles from BookManager into Trie
+void SearchAndSort::loadAllBooksToTrie()
+{
+    // Gather titles straight from the hash table and build the static trie in one pass
+    // Weights set on the previous index carry over to titles still in the catalog
+    vector<string> titles;
+    vector<uint32_t> weights;
+    vector<int> ids;
+    titles.reserve(bookManager->getBookCount());
+    bookManager->forEachBook([&](const Book &book)
+                             {
+                                 if (!book.getTitle().empty())
+                                 {
+                                     titles.push_back(book.getTitle());
+                                     weights.push_back(max(catalogTrie->weightOf(book.getTitle()), deltaTrie->weightOf(book.getTitle())));
+                                     ids.push_back(book.getId());
+                                 } });
+    catalogTrie->build(titles, weights, ids);
+
+    // The build covers every current title, so nothing is pending any more
+    delete deltaTrie;
+    deltaTrie = new RadixTrie();
+
+    cout << "Loaded " << bookManager->getBookCount() << " book titles into auto-complete." << endl;
+}
+
+// Search function - search books by partial title match
+vector<Book> SearchAndSort::searchBooksByTitle(const string &searchTerm)
+{
+    if (searchTerm.empty())
+    {
+        return vector<Book>();
+    }
+
+    // BookManager answers from its title index
+    return bookManager->searchBookByTitle(searchTerm);
 }
 
 // Sort books by title using merge sort
@@ -1,14 +1,62 @@
 #include "../test/PerformanceTest.h"
 #include "../DataStructures/header/HashTable.h"
+#include "../DataStructures/header/FlatHashTable.h"
+#include "../DataStructures/header/ConcurrentHashTable.h"
+#include "../DataStructures/header/EpochHashTable.h"
+#include "../DataStructures/header/DenseIdTable.h"
+#include "../DataStructures/header/BookSnapshot.h"
+#include "../DataStructures/header/linkedList.h"
+#include "../DataStructures/header/HistoryLog.h"
+#include "../DataStructures/header/LoanList.h"
 #include "../DataStructures/header/trie.h"
+#include "../DataStructures/header/RadixTrie.h"
+#include "../DataStructures/header/StaticTrie.h"
+#include "../DataStructures/header/TrigramIndex.h"
 #include "../DataStructures/header/mergeSort.h"
 #include "../entities/header/Book.h"
+#include "../modules/header/BookManager.h"
+#include "../modules/header/Borrower.h"
 #include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
 #include <random>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <mutex>
+#include <shared_mutex>
+
+// Counts every global operator new in the test binary, so tests can assert
+// how many heap allocations an operation performs
+static atomic<long long> heapAllocations(0);
+static atomic<long long> heapBytes(0); // requested bytes, never decremented
+
+void *operator new(size_t size)
+{
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    heapBytes.fetch_add((long long)size, memory_order_relaxed);
+    if (void *ptr = malloc(size ? size : 1))
+        return ptr;
+    throw bad_alloc();
+}
+
+// GCC flags free() inside a replaced operator delete once it is inlined into
+// a delete-expression; the pairing is correct, since operator new uses malloc
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
 PerformanceTest::PerformanceTest()
 {
@@ -75,6 +123,15 @@ vector<string> PerformanceTest::generateRandomStrings(int count)
     return strings;
 }
 
+template <typename Func>
+double PerformanceTest::measureTime(Func func)
+{
+    auto start = high_resolution_clock::now();
+    func();
+    auto end = high_resolution_clock::now();
+    return duration_cast<microseconds>(end - start).count() / 1000.0;
+}
+
 double PerformanceTest::averageTimings(const vector<double> &timings)
 {
     double sum = 0.0;
@@ -171,6 +228,888 @@ bool PerformanceTest::testHashTableCorrectness()
         allPassed = false;
     }
 
+    // Test 1.5: Growth and shrink across incremental rehashes
+    cout << "\n[1.5] Testing Resize (grow and shrink)..." << endl;
+    HashTable<int, int> resizing;
+    int initialBuckets = resizing.bucketCount();
+    bool resizeOk = true;
+
+    for (int i = 0; i < 5000; i++)
+        resizing.insert(i, i * 2);
+    int grownBuckets = resizing.bucketCount();
+
+    for (int i = 0; i < 5000; i++)
+    {
+        int *v = resizing.search(i);
+        if (!v || *v != i * 2)
+            resizeOk = false;
+    }
+    for (int i = 0; i < 5000; i++)
+        if (!resizing.remove(i))
+            resizeOk = false;
+
+    if (resizeOk && grownBuckets > initialBuckets && resizing.size() == 0 &&
+        resizing.bucketCount() < grownBuckets && resizing.loadFactor() <= resizing.getMaxLoadFactor())
+    {
+        cout << "✓ Resize: PASSED" << endl;
+        cout << "  - Buckets grew " << initialBuckets << " -> " << grownBuckets
+             << " and shrank back to " << resizing.bucketCount() << endl;
+    }
+    else
+    {
+        cout << "✗ Resize: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.6: Open-addressing table under insert/remove churn
+    cout << "\n[1.6] Testing FlatHashTable (tombstones and in-place rehash)..." << endl;
+    FlatHashTable<int, int> flat;
+    bool flatOk = true;
+
+    for (int round = 0; round < 20; round++)
+    {
+        // Insert a fresh block of keys and remove most of the previous one,
+        // leaving tombstones behind for the in-place rehash to reclaim
+        for (int i = 0; i < 500; i++)
+            flatOk = flatOk && flat.insert(round * 500 + i, i);
+        if (round > 0)
+            for (int i = 0; i < 450; i++)
+                flatOk = flatOk && flat.remove((round - 1) * 500 + i);
+    }
+    flatOk = flatOk && !flat.insert(19 * 500, 0); // duplicate rejected
+
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = 0; i < 500; i++)
+        {
+            int *v = flat.search(round * 500 + i);
+            bool shouldExist = (round == 19) || i >= 450;
+            if ((v != nullptr) != shouldExist || (v && *v != i))
+                flatOk = false;
+        }
+    }
+
+    if (flatOk && flat.size() == 19 * 50 + 500 && (int)flat.getAllEntries().size() == flat.size())
+    {
+        cout << "✓ FlatHashTable: PASSED" << endl;
+        cout << "  - " << flat.size() << " live keys in " << flat.bucketCount() << " slots after churn" << endl;
+    }
+    else
+    {
+        cout << "✗ FlatHashTable: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.7: string_view and precomputed-hash lookups
+    cout << "\n[1.7] Testing Heterogeneous (string_view) Lookup..." << endl;
+    HashTable<string, string> names;
+    FlatHashTable<string, LinkedList<string>> flatNames;
+    names.insert("tony stark", "Iron Man");
+    flatNames.insert("tony stark", LinkedList<string>());
+
+    string_view probe = string_view("tony stark|2025-12-12").substr(0, 10);
+    size_t probeHash = HashTable<string, string>::hashOf(probe);
+    string *viaView = names.search(probe);
+    string *viaHash = names.search(probe, probeHash);
+    bool flatHit = flatNames.search(probe, probeHash) != nullptr;
+    bool viewRemoved = names.remove(probe) && names.search(string("tony stark")) == nullptr;
+
+    // Under a non-default policy the chained and flat tables still agree on hashOf()
+    typedef HashTable<int, int, SlabAllocator, MixedHash, MaskReduction> MixedChained;
+    MixedChained mixedChained;
+    FlatHashTable<int, int, MixedHash> mixedFlat;
+    mixedChained.insert(42, 1);
+    mixedFlat.insert(42, 2);
+    size_t mixedHash = MixedChained::hashOf(42);
+    bool policyShared = mixedHash == FlatHashTable<int, int, MixedHash>::hashOf(42) &&
+                        mixedChained.search(42, mixedHash) && mixedFlat.search(42, mixedHash);
+
+    if (viaView && *viaView == "Iron Man" && viaHash == viaView && flatHit && viewRemoved && policyShared &&
+        probeHash == HashTable<string, string>::hashOf(string("tony stark")))
+    {
+        cout << "✓ Heterogeneous Lookup: PASSED" << endl;
+        cout << "  - Found, re-used hash across tables and removed via string_view" << endl;
+    }
+    else
+    {
+        cout << "✗ Heterogeneous Lookup: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.8: In-place iteration, including mid-rehash
+    cout << "\n[1.8] Testing Iterators and forEach..." << endl;
+    HashTable<int, int> iterTable;
+    long long expectedSum = 0;
+    bool sawRehash = false;
+    bool iterOk = true;
+
+    for (int i = 1; i <= 3000; i++)
+    {
+        iterTable.insert(i, i);
+        expectedSum += i;
+
+        // Every so often, scan while part of the table may still sit in the old bucket array
+        if (i % 250 == 0)
+        {
+            sawRehash = sawRehash || iterTable.isRehashing();
+            long long iterSum = 0, visitSum = 0;
+            int iterCount = 0;
+            for (const auto &node : iterTable)
+            {
+                iterSum += node.value;
+                iterCount++;
+            }
+            iterTable.forEach([&](const int &, const int &value)
+                              { visitSum += value; });
+            if (iterSum != expectedSum || visitSum != expectedSum || iterCount != iterTable.size())
+                iterOk = false;
+        }
+    }
+
+    FlatHashTable<int, int> iterFlat;
+    for (int i = 1; i <= 100; i++)
+        iterFlat.insert(i, i);
+    long long flatSum = 0;
+    for (const auto &slot : iterFlat)
+        flatSum += slot.value;
+
+    if (iterOk && flatSum == 5050)
+    {
+        cout << "✓ Iterators: PASSED" << endl;
+        cout << "  - Scans matched the table contents" << (sawRehash ? " (including mid-rehash)" : "") << endl;
+    }
+    else
+    {
+        cout << "✗ Iterators: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.9: Lock-free readers racing a writer that updates, removes and grows
+    cout << "\n[1.9] Testing EpochHashTable (concurrent readers)..." << endl;
+    EpochHashTable<int, int> epochTable;
+    const int epochKeys = 2000;
+    for (int i = 0; i < epochKeys; i++)
+        epochTable.insert(i, i);
+
+    atomic<bool> writerDone(false);
+    atomic<int> tornReads(0);
+    vector<thread> readers;
+    for (int t = 0; t < 3; t++)
+    {
+        readers.emplace_back([&, t]()
+                             {
+                                 int key = t;
+                                 while (!writerDone.load())
+                                 {
+                                     EpochGuard guard;
+                                     int *val = epochTable.search(key % (epochKeys * 2));
+                                     // Every stored value is key + version * 1000000
+                                     if (val && *val % 1000000 != key % (epochKeys * 2))
+                                         tornReads++;
+                                     key += 7;
+                                 }
+                             });
+    }
+
+    for (int round = 1; round <= 20; round++)
+    {
+        for (int i = 0; i < epochKeys; i += 3)
+            epochTable.update(i, i + round * 1000000);
+        for (int i = 1; i < epochKeys; i += 5)
+            epochTable.remove(i);
+        for (int i = 1; i < epochKeys; i += 5)
+            epochTable.insert(i, i + round * 1000000);
+    }
+    for (int i = epochKeys; i < epochKeys * 2; i++)
+        epochTable.insert(i, i); // forces the bucket array to grow under the readers
+    writerDone = true;
+    for (thread &reader : readers)
+        reader.join();
+
+    bool epochOk = tornReads == 0 && epochTable.size() == epochKeys * 2;
+    for (int i = 0; i < epochKeys * 2 && epochOk; i++)
+    {
+        int *val = epochTable.search(i);
+        epochOk = val && *val % 1000000 == i;
+    }
+
+    if (epochOk)
+    {
+        cout << "✓ EpochHashTable: PASSED" << endl;
+        cout << "  - No torn reads; " << epochTable.pendingReclaim() << " retired nodes awaiting reclamation" << endl;
+    }
+    else
+    {
+        cout << "✗ EpochHashTable: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.10: A first borrow builds one list node and copies nothing
+    cout << "\n[1.10] Testing Move-aware insert (allocation count)..." << endl;
+    HashTable<string, LinkedList<string>> lists;
+    lists.try_emplace("warm-up").first->insertAtEnd("x"); // table slab now has free node blocks
+    string userKey = "a borrower name long enough to live on the heap";
+    string entry = "a book title long enough to live on the heap|2025-01-01";
+
+    // Cost of a one-node list on its own: the list's first slab (plus its size class)
+    long long before = heapAllocations.load();
+    {
+        LinkedList<string> probe;
+        probe.insertAtEnd(string());
+    }
+    long long oneNodeList = heapAllocations.load() - before;
+
+    // try_emplace + moved entry must cost no more than that, plus the key copy
+    before = heapAllocations.load();
+    lists.try_emplace(userKey).first->insertAtEnd(std::move(entry));
+    long long emplaceCost = heapAllocations.load() - before;
+
+    // Moving a built list into the table must not allocate at all
+    LinkedList<string> built;
+    built.insertAtEnd(string(60, 'y'));
+    before = heapAllocations.load();
+    lists.insert(string("moved key"), std::move(built));
+    long long moveInsertCost = heapAllocations.load() - before;
+
+    LinkedList<string> *stored = lists.search(string_view("moved key"));
+    bool moveOk = emplaceCost == oneNodeList + 1 && moveInsertCost == 0 &&
+                  stored && stored->search(string(60, 'y')) && entry.empty();
+
+    if (moveOk)
+    {
+        cout << "✓ Move-aware insert: PASSED" << endl;
+        cout << "  - try_emplace + move: " << emplaceCost << " allocations (node slab + key), move insert: 0" << endl;
+    }
+    else
+    {
+        cout << "✗ Move-aware insert: FAILED (try_emplace " << emplaceCost << ", expected " << oneNodeList + 1
+             << "; move insert " << moveInsertCost << ", expected 0)" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.11: Bulk load with first-wins / last-wins duplicate handling
+    cout << "\n[1.11] Testing Bulk Load (duplicate policies)..." << endl;
+    auto batch = []()
+    {
+        return vector<pair<int, int>>{{1, 10}, {2, 20}, {1, 11}, {3, 30}, {2, 21}};
+    };
+
+    HashTable<int, int> lastWins;
+    HashTable<int, int> firstWins;
+    FlatHashTable<int, int> flatLastWins;
+    EpochHashTable<int, int> epochFirstWins;
+    int addedLast = lastWins.bulkLoad(batch(), DuplicatePolicy::KeepLast);
+    int addedFirst = firstWins.bulkLoad(batch(), DuplicatePolicy::KeepFirst);
+    int addedFlat = flatLastWins.bulkLoad(batch(), DuplicatePolicy::KeepLast);
+    int addedEpoch = epochFirstWins.bulkLoad(batch(), DuplicatePolicy::KeepFirst);
+
+    // A second batch against a filled table: key 3 already stored, 4 is new
+    int addedAgain = lastWins.bulkLoad({{3, 31}, {4, 40}}, DuplicatePolicy::KeepLast);
+
+    bool bulkOk = addedLast == 3 && addedFirst == 3 && addedFlat == 3 && addedEpoch == 3 && addedAgain == 1 &&
+                  lastWins.size() == 4 && *lastWins.search(1) == 11 && *lastWins.search(2) == 21 &&
+                  *lastWins.search(3) == 31 && *lastWins.search(4) == 40 &&
+                  firstWins.size() == 3 && *firstWins.search(1) == 10 && *firstWins.search(2) == 20 &&
+                  flatLastWins.size() == 3 && *flatLastWins.search(1) == 11 &&
+                  epochFirstWins.size() == 3 && *epochFirstWins.search(2) == 20;
+
+    if (bulkOk)
+    {
+        cout << "✓ Bulk Load: PASSED" << endl;
+        cout << "  - Repeated keys resolved last-wins and first-wins, no shadow entries" << endl;
+    }
+    else
+    {
+        cout << "✗ Bulk Load: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.12: stats() agrees with the table contents under every policy
+    cout << "\n[1.12] Testing Hash Policies and stats()..." << endl;
+    HashTable<int, int> defaultPolicy;
+    HashTable<int, int, SlabAllocator, MixedHash, MaskReduction> maskPolicy(100); // rounded up to 128
+    HashTable<int, int, SlabAllocator, MixedHash, FastRangeReduction> rangePolicy;
+    for (int i = 0; i < 5000; i++)
+    {
+        defaultPolicy.insert(i * 64, i);
+        maskPolicy.insert(i * 64, i);
+        rangePolicy.insert(i * 64, i);
+    }
+
+    auto statsConsistent = [](const HashTableStats &st)
+    {
+        long long buckets = 0, entries = 0;
+        for (size_t len = 0; len < st.histogram.size(); len++)
+        {
+            buckets += st.histogram[len];
+            entries += (long long)len * st.histogram[len];
+        }
+        return entries == st.size && buckets >= st.buckets && st.p99Chain <= st.maxChain &&
+               st.maxChain == (int)st.histogram.size() - 1;
+    };
+
+    HashTableStats maskStats = maskPolicy.stats();
+    bool policyOk = statsConsistent(defaultPolicy.stats()) && statsConsistent(maskStats) &&
+                    statsConsistent(rangePolicy.stats()) && (maskPolicy.bucketCount() & (maskPolicy.bucketCount() - 1)) == 0 &&
+                    maskPolicy.search(64 * 4999) && *rangePolicy.search(64 * 1234) == 1234;
+
+    if (policyOk)
+    {
+        cout << "✓ Hash Policies: PASSED" << endl;
+        cout << "  - MixedHash + mask on stride-64 IDs: max chain " << maskStats.maxChain
+             << ", p99 " << maskStats.p99Chain << endl;
+    }
+    else
+    {
+        cout << "✗ Hash Policies: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.13: Dense ID store picks its mode from the ID density
+    cout << "\n[1.13] Testing DenseIdTable (direct and hashed modes)..." << endl;
+    DenseIdTable<int> denseIds;
+    vector<pair<int, int>> accessions;
+    for (int id = 5000; id < 15000; id++)
+        accessions.push_back(make_pair(id, id * 2));
+    accessions.push_back(make_pair(-7000000, 1));   // far below the range
+    accessions.push_back(make_pair(90000000, 2));   // far above it
+    accessions.push_back(make_pair(5000, 10000));   // duplicate, same value
+    int denseAdded = denseIds.bulkLoad(std::move(accessions));
+
+    DenseIdTable<int> sparseIds;
+    vector<pair<int, int>> scattered;
+    for (int i = 0; i < 2000; i++)
+        scattered.push_back(make_pair(i * 997, i));
+    sparseIds.bulkLoad(std::move(scattered));
+
+    bool denseOk = denseAdded == 10002 && denseIds.isDirect() && denseIds.outlierCount() == 2 &&
+                   *denseIds.search(12345) == 24690 && *denseIds.search(-7000000) == 1 && *denseIds.search(90000000) == 2 &&
+                   !denseIds.search(4999) && !sparseIds.isDirect() && *sparseIds.search(997 * 1500) == 1500;
+
+    // Appending the next accession numbers extends the direct range; removal keeps records contiguous
+    for (int id = 15000; id < 15100; id++)
+        denseOk = denseOk && denseIds.insert(id, id * 2);
+    denseOk = denseOk && !denseIds.insert(15000, 0) && denseIds.remove(5000) && denseIds.remove(90000000) &&
+              !denseIds.search(5000) && *denseIds.search(15099) == 30198 && denseIds.size() == 10100 &&
+              denseIds.outlierCount() == 1 && (int)denseIds.getAllEntries().size() == denseIds.size();
+
+    if (denseOk)
+    {
+        cout << "✓ DenseIdTable: PASSED" << endl;
+        cout << "  - " << denseIds.directSlots() << " direct slots, " << denseIds.outlierCount()
+             << " outlier; scattered IDs fell back to hashing" << endl;
+    }
+    else
+    {
+        cout << "✗ DenseIdTable: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.14: Bloom filter answers misses and never hides a stored key
+    cout << "\n[1.14] Testing Bloom filter for negative lookups..." << endl;
+    HashTable<int, int> filtered;
+    filtered.enableBloomFilter(0.01);
+    for (int i = 0; i < 10000; i++)
+        filtered.insert(i, i); // grows well past the filter's initial sizing
+
+    bool bloomOk = filtered.hasBloomFilter();
+    for (int i = 0; i < 10000; i++)
+        bloomOk = bloomOk && filtered.search(i) && *filtered.search(i) == i;
+
+    long long skipBase = filtered.bloomSkippedProbes();
+    for (int i = 10000; i < 20000; i++)
+        bloomOk = bloomOk && !filtered.search(i);
+    double missSkipRate = (filtered.bloomSkippedProbes() - skipBase) / 10000.0;
+    bloomOk = bloomOk && missSkipRate >= 0.97; // 1% target, some slack for block imbalance
+
+    // Removals leave stale bits until the filter rebuilds itself
+    for (int i = 0; i < 8000; i++)
+        bloomOk = bloomOk && filtered.remove(i);
+    for (int i = 0; i < 10000; i++)
+        bloomOk = bloomOk && (filtered.search(i) != nullptr) == (i >= 8000);
+
+    skipBase = filtered.bloomSkippedProbes();
+    for (int i = 0; i < 8000; i++)
+        filtered.search(i);
+    double removedSkipRate = (filtered.bloomSkippedProbes() - skipBase) / 8000.0;
+    bloomOk = bloomOk && removedSkipRate >= 0.9 && !filtered.remove(-1);
+
+    HashTable<string, string> filteredNames;
+    filteredNames.insert("alice", "a");
+    filteredNames.enableBloomFilter(0.01);
+    filteredNames.insert("bob", "b");
+    bloomOk = bloomOk && filteredNames.search(string_view("alice")) && filteredNames.search(string_view("bob")) &&
+              !filteredNames.search(string_view("mallory"));
+
+    if (bloomOk)
+    {
+        cout << "✓ Bloom Filter: PASSED" << endl;
+        cout << "  - " << fixed << setprecision(1) << missSkipRate * 100 << "% of misses skipped, "
+             << removedSkipRate * 100 << "% after removals, " << filtered.bloomMemoryBytes() << " filter bytes" << endl;
+    }
+    else
+    {
+        cout << "✗ Bloom Filter: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.15: Snapshot round trip, queried in place from the mapping
+    cout << "\n[1.15] Testing memory-mapped book snapshot..." << endl;
+    const string snapshotFile = "test_snapshot.bin";
+    vector<Book> snapshotBooks = generateBooks(5000);
+    BookSnapshotWriter writer;
+    for (const Book &book : snapshotBooks)
+        writer.add(book);
+
+    BookSnapshot mapped;
+    bool snapshotOk = writer.write(snapshotFile) && mapped.open(snapshotFile, true) && mapped.size() == 5000;
+    for (int i = 0; snapshotOk && i < (int)snapshotBooks.size(); i += 97)
+    {
+        const SnapshotRecord *record = mapped.find(snapshotBooks[i].getId());
+        snapshotOk = record && mapped.title(*record) == snapshotBooks[i].getTitle() &&
+                     mapped.toBook(*record).getAuthor() == snapshotBooks[i].getAuthor() &&
+                     record->year == snapshotBooks[i].getYear();
+    }
+    snapshotOk = snapshotOk && !mapped.find(-1) && mapped.verify();
+    mapped.close();
+
+    // A flipped data byte fails the checksum; a flipped header byte fails even a quick open
+    {
+        fstream corrupt(snapshotFile, ios::in | ios::out | ios::binary);
+        corrupt.seekp(sizeof(SnapshotHeader) + 16);
+        corrupt.put('\x5a');
+    }
+    snapshotOk = snapshotOk && !mapped.open(snapshotFile, true);
+    {
+        fstream corrupt(snapshotFile, ios::in | ios::out | ios::binary);
+        corrupt.seekp(24);
+        corrupt.put('\x5a');
+    }
+    snapshotOk = snapshotOk && !mapped.open(snapshotFile) && !mapped.isOpen();
+
+    // A crafted header with a valid checksum: an offset near 2^64 that would
+    // wrap the section sums back into range must still be rejected
+    {
+        SnapshotHeader crafted;
+        {
+            writer.write(snapshotFile);
+            ifstream in(snapshotFile, ios::binary);
+            in.read((char *)&crafted, sizeof(crafted));
+        }
+        crafted.bucketsOffset = ~(uint64_t)7; // 2^64 - 8, still a multiple of 8
+        crafted.headerChecksum = BookSnapshot::checksum((const unsigned char *)&crafted, offsetof(SnapshotHeader, headerChecksum));
+        fstream out(snapshotFile, ios::in | ios::out | ios::binary);
+        out.write((const char *)&crafted, sizeof(crafted));
+    }
+    snapshotOk = snapshotOk && !mapped.open(snapshotFile) && !mapped.isOpen();
+    remove(snapshotFile.c_str());
+
+    if (snapshotOk)
+    {
+        cout << "✓ Book Snapshot: PASSED" << endl;
+        cout << "  - 5000 books mapped and queried in place; corrupted and crafted headers and data rejected" << endl;
+    }
+    else
+    {
+        cout << "✗ Book Snapshot: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.16: LinkedList keeps its tail and size through appends and removals
+    cout << "\n[1.16] Testing LinkedList tail, size and iterators..." << endl;
+    LinkedList<string> entries;
+    for (int i = 0; i < 5; i++)
+        entries.insertAtEnd("entry " + to_string(i));
+
+    bool listOk = entries.size() == 5 && entries.front() == "entry 0" && entries.back() == "entry 4";
+    listOk = listOk && entries.remove("entry 4") && entries.back() == "entry 3" && entries.remove("entry 0") &&
+             entries.front() == "entry 1" && entries.size() == 3;
+    entries.insertAtEnd("entry 5"); // appended after the new tail, not the removed one
+
+    string walked;
+    for (const string &entry : entries)
+        walked += entry.back();
+    const LinkedList<string> &readOnly = entries;
+    int constCount = (int)distance(readOnly.begin(), readOnly.end());
+    listOk = listOk && walked == "1235" && constCount == 4 && entries.back() == "entry 5";
+
+    LinkedList<string> movedEntries(std::move(entries));
+    movedEntries.insertAtEnd("entry 6");
+    listOk = listOk && movedEntries.size() == 5 && movedEntries.back() == "entry 6" && entries.empty();
+    entries.insertAtEnd("fresh"); // a moved-from list is empty and usable
+    movedEntries.clear();
+    listOk = listOk && entries.size() == 1 && entries.front() == "fresh" && movedEntries.empty() &&
+             movedEntries.begin() == movedEntries.end();
+
+    if (listOk)
+    {
+        cout << "✓ LinkedList: PASSED" << endl;
+        cout << "  - O(1) append through the tail pointer; size and iteration stay in sync" << endl;
+    }
+    else
+    {
+        cout << "✗ LinkedList: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.17: History log keeps events in order and shares repeated strings
+    cout << "\n[1.17] Testing HistoryLog (chunked, interned history events)..." << endl;
+    HistoryLog historyLog;
+    const int historyEvents = 10000; // spans several chunks
+    for (int i = 0; i < historyEvents; i++)
+        historyLog.append("user" + to_string(i % 10), "Title " + to_string(i % 50), "2025-01-0" + to_string(1 + i % 9),
+                          i % 2 ? "return" : "borrow");
+    historyLog.appendNote("manual note, kept verbatim");
+
+    HistoryLog::Entry middle = historyLog[4321];
+    bool historyOk = historyLog.size() == historyEvents + 1 && middle.user == "user1" && middle.title == "Title 21" &&
+                     middle.action == "return" && middle.toLine() == "user1,Title 21,2025-01-02,return" &&
+                     historyLog.internedStrings() == 10 + 50 + 9 + 2 + 1;
+
+    // Reverse iteration starts at the newest event
+    auto newest = historyLog.rbegin();
+    historyOk = historyOk && (*newest).note && (*newest).toLine() == "manual note, kept verbatim";
+    ++newest;
+    historyOk = historyOk && (*newest).toLine() == "user9,Title 49,2025-01-01,return";
+
+    size_t forwardCount = 0, reverseCount = 0;
+    for (auto it = historyLog.begin(); it != historyLog.end(); ++it)
+        forwardCount++;
+    for (auto it = historyLog.rbegin(); it != historyLog.rend(); ++it)
+        reverseCount++;
+    historyOk = historyOk && forwardCount == historyLog.size() && reverseCount == historyLog.size() &&
+                (*historyLog.begin()).toLine() == "user0,Title 0,2025-01-01,borrow";
+
+    if (historyOk)
+    {
+        cout << "✓ HistoryLog: PASSED" << endl;
+        cout << "  - " << historyLog.size() << " events over " << historyLog.internedStrings()
+             << " distinct strings; newest-first iteration" << endl;
+    }
+    else
+    {
+        cout << "✗ HistoryLog: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.18: A loan is linked into two lists at once and leaves both in O(1)
+    cout << "\n[1.18] Testing LoanList (intrusive per-user and per-book loan lists)..." << endl;
+    LoanList aliLoans(BY_USER), bobLoans(BY_USER), bookLoans(BY_BOOK);
+    Loan first("ali", "Dune", "2025-01-01"), second("ali", "Emma", "2025-01-02"), third("ali", "Ulysses", "2025-01-03");
+    Loan other("bob", "Dune", "2025-01-04");
+    for (Loan *loan : {&first, &second, &third})
+        aliLoans.pushBack(loan);
+    bobLoans.pushBack(&other);
+    bookLoans.pushBack(&first);
+    bookLoans.pushBack(&other);
+
+    auto titlesOf = [](const LoanList &list)
+    {
+        string joined;
+        for (const Loan &loan : list)
+            joined += loan.title + ";";
+        return joined;
+    };
+    auto usersOf = [](const LoanList &list)
+    {
+        string joined;
+        for (const Loan &loan : list)
+            joined += loan.user + ";";
+        return joined;
+    };
+
+    bool loansOk = aliLoans.size() == 3 && titlesOf(aliLoans) == "Dune;Emma;Ulysses;" && usersOf(bookLoans) == "ali;bob;";
+
+    // Middle, then head, then tail; the other side's list is untouched
+    aliLoans.unlink(&second);
+    loansOk = loansOk && titlesOf(aliLoans) == "Dune;Ulysses;" && usersOf(bookLoans) == "ali;bob;";
+    aliLoans.unlink(&first);
+    bookLoans.unlink(&first);
+    loansOk = loansOk && aliLoans.front().title == "Ulysses" && bookLoans.front().user == "bob" && bookLoans.size() == 1;
+    aliLoans.unlink(&third);
+    bookLoans.unlink(&other);
+    loansOk = loansOk && aliLoans.empty() && bookLoans.empty() && aliLoans.begin() == aliLoans.end() &&
+              bobLoans.front().title == "Dune";
+
+    aliLoans.pushBack(&second); // an emptied list takes new loans
+    loansOk = loansOk && aliLoans.size() == 1 && titlesOf(aliLoans) == "Emma;";
+
+    if (loansOk)
+    {
+        cout << "✓ LoanList: PASSED" << endl;
+        cout << "  - unlinking from head, middle and tail keeps both sides consistent" << endl;
+    }
+    else
+    {
+        cout << "✗ LoanList: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.19: Trigram index, confirmed candidates against a scan, through renames and deletes
+    cout << "\n[1.19] Testing TrigramIndex (substring search over titles)..." << endl;
+    map<int, string> indexedTitles;
+    TrigramIndex trigramIndex;
+    for (const Book &book : generateBooks(3000))
+    {
+        // Mixed case, and a shared word so some trigrams are in every title
+        string title = book.getTitle() + (book.getId() % 7 == 0 ? " SEQUEL" : "");
+        indexedTitles[book.getId()] = title;
+        trigramIndex.add(book.getId(), title);
+    }
+
+    auto lowered = [](string text)
+    {
+        transform(text.begin(), text.end(), text.begin(), ::tolower);
+        return text;
+    };
+    auto indexedSearch = [&](const string &term)
+    {
+        vector<int> ids, matches;
+        trigramIndex.candidates(lowered(term), ids);
+        for (int id : ids)
+            if (lowered(indexedTitles[id]).find(lowered(term)) != string::npos)
+                matches.push_back(id);
+        return matches;
+    };
+    auto scannedSearch = [&](const string &term)
+    {
+        vector<int> matches;
+        for (const pair<const int, string> &entry : indexedTitles)
+            if (lowered(entry.second).find(lowered(term)) != string::npos)
+                matches.push_back(entry.first);
+        return matches;
+    };
+
+    vector<string> substringTerms = {"Vol 1", "vol 12", "ocean DEP", "sequel", "night vol 3", "wisdom vol 29",
+                                     "the", "Tales Vol 300", "not there", "xyz"};
+    vector<int> shortTermIds;
+    bool trigramOk = !trigramIndex.candidates("ab", shortTermIds); // too short for the index
+    for (int round = 0; round < 2; round++)
+    {
+        for (const string &term : substringTerms)
+            trigramOk = trigramOk && indexedSearch(term) == scannedSearch(term);
+
+        // Rename a third of the titles and drop another third
+        for (int id = 1; id <= 3000 && round == 0; id += 3)
+        {
+            trigramIndex.remove(id, indexedTitles[id]);
+            indexedTitles[id] = "Ocean Depths Vol " + to_string(id) + " (revised)";
+            trigramIndex.add(id, indexedTitles[id]);
+            trigramIndex.remove(id + 1, indexedTitles[id + 1]);
+            indexedTitles.erase(id + 1);
+        }
+        substringTerms.push_back("revised");
+    }
+    vector<int> absentTermIds;
+    trigramOk = trigramOk && trigramIndex.candidates("zzzz", absentTermIds) && absentTermIds.empty();
+
+    // BookManager returns matches in ID order from the index and from the
+    // scan it falls back to for short terms, over a hash table and over a
+    // snapshot whose edited books sit in the overlay
+    const string titleCsvFile = "test_titles.csv";
+    const string titleSnapshotFile = "test_titles.snap";
+    {
+        ofstream csv(titleCsvFile);
+        for (const pair<const int, string> &entry : indexedTitles)
+            csv << entry.first << "," << entry.second << ",author,2000,pub\n";
+    }
+    auto managerSearch = [](BookManager &manager, const string &term)
+    {
+        vector<int> ids;
+        for (const Book &book : manager.searchBookByTitle(term))
+            ids.push_back(book.getId());
+        return ids;
+    };
+    vector<string> managerTerms = {"vo", "S", "ol 1", "revised", "ocean dep", "SEQUEL"};
+    {
+        BookManager loaded;
+        loaded.loadBooksFromCSV(titleCsvFile);
+        trigramOk = trigramOk && loaded.saveSnapshot(titleSnapshotFile);
+        for (const string &term : managerTerms)
+            trigramOk = trigramOk && managerSearch(loaded, term) == scannedSearch(term);
+
+        BookManager mapped;
+        mapped.setCsvFilePath(""); // never auto-save over the default book.csv
+        trigramOk = trigramOk && mapped.openSnapshot(titleSnapshotFile);
+        for (int id = 3000; id > 2900; id -= 3)
+        {
+            if (indexedTitles.count(id) && mapped.updateBook(id, "Vol " + to_string(id) + " reSEQUELed", "author", 2001))
+                indexedTitles[id] = "Vol " + to_string(id) + " reSEQUELed";
+        }
+        for (const string &term : managerTerms)
+            trigramOk = trigramOk && managerSearch(mapped, term) == scannedSearch(term);
+    }
+    remove(titleCsvFile.c_str());
+    remove(titleSnapshotFile.c_str());
+
+    if (trigramOk)
+    {
+        cout << "✓ Trigram Index: PASSED" << endl;
+        cout << "  - substring matches equal a full scan after renames and deletes, and BookManager lists them in ID order; "
+             << trigramIndex.trigramCount() << " trigrams indexed" << endl;
+    }
+    else
+    {
+        cout << "✗ Trigram Index: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.20: Striped table under concurrent inserts, updates, removes and searches
+    cout << "\n[1.20] Testing ConcurrentHashTable (multi-threaded consistency)..." << endl;
+    ConcurrentHashTable<int, Book> stripedTable;
+    const int stripedWriters = 4;
+    const int keysPerWriter = 2000;
+    const int stripedRounds = 5;
+    // A value's title spells its key and version (kept in the year), so a
+    // torn read shows up as a mismatch
+    auto stripedBook = [](int key, int version)
+    {
+        return Book(key, "book " + to_string(key) + " v" + to_string(version), "author", version, "pub");
+    };
+
+    atomic<bool> stripedDone(false);
+    atomic<int> stripedTorn(0);
+    vector<thread> stripedReaders;
+    for (int t = 0; t < 3; t++)
+    {
+        stripedReaders.emplace_back([&, t]()
+                                    {
+                                        Book copy;
+                                        int key = t;
+                                        while (!stripedDone.load())
+                                        {
+                                            int probe = key % (stripedWriters * keysPerWriter);
+                                            if (stripedTable.search(probe, copy) &&
+                                                (copy.getId() != probe || copy.getTitle() != stripedBook(probe, copy.getYear()).getTitle()))
+                                                stripedTorn++;
+                                            key += 13;
+                                        }
+                                    });
+    }
+
+    // Each writer owns a key range: insert all, then per round update every
+    // key and remove and re-insert every fifth (the stripes grow meanwhile)
+    vector<thread> stripedWriterThreads;
+    atomic<int> stripedWriteFailures(0);
+    for (int w = 0; w < stripedWriters; w++)
+    {
+        stripedWriterThreads.emplace_back([&, w]()
+                                          {
+                                              int first = w * keysPerWriter;
+                                              for (int k = first; k < first + keysPerWriter; k++)
+                                                  stripedWriteFailures += !stripedTable.insert(k, stripedBook(k, 0));
+                                              for (int round = 1; round <= stripedRounds; round++)
+                                              {
+                                                  for (int k = first; k < first + keysPerWriter; k++)
+                                                      stripedWriteFailures += !stripedTable.update(k, stripedBook(k, round));
+                                                  for (int k = first; k < first + keysPerWriter; k += 5)
+                                                  {
+                                                      stripedWriteFailures += !stripedTable.remove(k);
+                                                      stripedWriteFailures += !stripedTable.insert(k, stripedBook(k, round));
+                                                  }
+                                              }
+                                          });
+    }
+    for (thread &writer : stripedWriterThreads)
+        writer.join();
+    stripedDone = true;
+    for (thread &reader : stripedReaders)
+        reader.join();
+
+    bool stripedOk = stripedTorn == 0 && stripedWriteFailures == 0 &&
+                     stripedTable.size() == stripedWriters * keysPerWriter &&
+                     (int)stripedTable.getAllEntries().size() == stripedWriters * keysPerWriter;
+    Book stripedCopy;
+    for (int k = 0; k < stripedWriters * keysPerWriter && stripedOk; k++)
+        stripedOk = stripedTable.search(k, stripedCopy) && stripedCopy.getYear() == stripedRounds &&
+                    stripedCopy.getTitle() == stripedBook(k, stripedRounds).getTitle();
+    stripedOk = stripedOk && !stripedTable.search(-1, stripedCopy);
+
+    if (stripedOk)
+    {
+        cout << "✓ ConcurrentHashTable: PASSED" << endl;
+        cout << "  - " << stripedWriters << " writers and 3 readers; no torn reads, every key at its last version" << endl;
+    }
+    else
+    {
+        cout << "✗ ConcurrentHashTable: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.21: A repeated borrow row opens one loan, counted once, that one return closes
+    cout << "\n[1.21] Testing Borrower replay of a duplicate borrow row..." << endl;
+    const string borrowCsvFile = "test_borrows.csv";
+    {
+        ofstream csv(borrowCsvFile);
+        csv << "ann,Dune,2024-01-01,borrow\n"
+            << "ann,Dune,2024-01-01,borrow\n" // written twice
+            << "bob,Emma,2024-01-02,borrow\n";
+    }
+    auto replayOk = [&](auto &borrower)
+    {
+        const LoanList *annLoans = borrower.getUserActiveBorrows("ann");
+        const LoanList *duneLoans = borrower.getBookActiveBorrowers("Dune");
+        bool ok = borrower.getActiveLoanCount() == 2 && borrower.getBorrowCount("Dune") == 1 &&
+                  annLoans && annLoans->size() == 1 && duneLoans && duneLoans->size() == 1;
+        // One return clears the loan from the index and both lists
+        ok = ok && borrower.returnBook("ann", "Dune", "2024-01-09") && borrower.getActiveLoanCount() == 1 &&
+             !borrower.getUserActiveBorrows("ann") && !borrower.getBookActiveBorrowers("Dune") &&
+             !borrower.returnBook("ann", "Dune", "2024-01-10");
+        return ok;
+    };
+    bool replayPassed;
+    {
+        Borrower chained(borrowCsvFile);
+        replayPassed = replayOk(chained);
+    }
+    {
+        ofstream csv(borrowCsvFile, ios::app);
+        csv << "ann,Dune,2024-01-11,borrow\n"; // a fresh loan after the returns
+    }
+    {
+        FlatBorrower flat(borrowCsvFile);
+        replayPassed = replayPassed && flat.getBorrowCount("Dune") == 2 && flat.getActiveLoanCount() == 2;
+    }
+    remove(borrowCsvFile.c_str());
+
+    if (replayPassed)
+    {
+        cout << "✓ Borrow Replay: PASSED" << endl;
+        cout << "  - a duplicated borrow row leaves one loan in the index and both lists" << endl;
+    }
+    else
+    {
+        cout << "✗ Borrow Replay: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 1.22: A small maxLoadFactor is honoured even while a rehash is in flight
+    cout << "\n[1.22] Testing HashTable load bound with a low maxLoadFactor..." << endl;
+    bool boundPassed = true;
+    {
+        HashTable<int, int> sparse(16, 0.1);
+        for (int i = 0; i < 5000 && boundPassed; i++)
+        {
+            sparse.insert(i, i);
+            boundPassed = sparse.loadFactor() <= sparse.getMaxLoadFactor();
+        }
+        sparse.setMaxLoadFactor(0.01);
+        boundPassed = boundPassed && sparse.loadFactor() <= 0.01;
+        for (int i = 0; i < 5000 && boundPassed; i++)
+            boundPassed = sparse.search(i) && *sparse.search(i) == i;
+    }
+
+    if (boundPassed)
+    {
+        cout << "✓ Load Bound: PASSED" << endl;
+        cout << "  - growth during a pending rehash finishes it first instead of waiting" << endl;
+    }
+    else
+    {
+        cout << "✗ Load Bound: FAILED" << endl;
+        allPassed = false;
+    }
+
     cout << "\n"
          << (allPassed ? "✓✓✓ Hash Table Test: ALL PASSED ✓✓✓" : "✗✗✗ Hash Table Test: SOME FAILED ✗✗✗") << endl;
     return allPassed;
@@ -360,22 +1299,547 @@ bool PerformanceTest::testTrieCorrectness()
         cout << "✗ Empty prefix: WARNING - may not return all words" << endl;
     }
 
-    cout << "\n"
-         << (allPassed ? "✓✓✓ Trie Test: ALL PASSED ✓✓✓" : "✗✗✗ Trie Test: SOME FAILED ✗✗✗") << endl;
-    return allPassed;
-}
-
-// === PERFORMANCE TESTS ===
-
-void PerformanceTest::benchmarkHashTable()
-{
-    cout << "\n\n=== PERFORMANCE BENCHMARK 1: Hash Table Operations ===" << endl;
-    cout << "Expected Complexity: O(1) average case for insert/search" << endl;
-    cout << "Testing on input sizes: 10³, 10⁴, 10⁵" << endl;
+    // Test 3.5: The radix trie answers exactly as the Trie does
+    cout << "\n[3.5] Testing RadixTrie against Trie..." << endl;
+    RadixTrie radix;
+    vector<string> radixWords = testWords;
+    for (const char *word : {"App", "APPLE pie", "ca", "", "band", "bandanas", "Café au lait"})
+        radixWords.push_back(word); // case folding, a duplicate, an empty key, a non-ASCII byte
+    for (const string &word : generateRandomStrings(2000))
+        radixWords.push_back(word);
+    for (const string &word : radixWords)
+    {
+        trie.insert(word);
+        radix.insert(word);
+    }
 
-    vector<int> sizes = {1000, 10000, 100000};
+    bool radixOk = radix.size() == (int)trie.getAutoComplete("").size();
+    for (const char *prefix : {"", "a", "App", "apple ", "ban", "bandana", "c", "CA", "caf", "xyz", "z", "caf\xc3", "qq"})
+        radixOk = radixOk && radix.getAutoComplete(prefix) == trie.getAutoComplete(prefix);
+    for (size_t i = 0; i < 200; i++)
+    {
+        const string &word = radixWords[radixWords.size() - 1 - i];
+        string prefix = word.substr(0, i % (word.size() + 1));
+        radixOk = radixOk && radix.getAutoComplete(prefix) == trie.getAutoComplete(prefix);
+    }
 
-    for (int size : sizes)
+    if (radixOk)
+    {
+        cout << "✓ RadixTrie: PASSED" << endl;
+        cout << "  - " << radix.size() << " keys in " << radix.memoryBytes() << " bytes; completions match Trie" << endl;
+    }
+    else
+    {
+        cout << "✗ RadixTrie: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.6: The static LOUDS trie answers as the Trie does, and a rebuild replaces its keys
+    cout << "\n[3.6] Testing StaticTrie (LOUDS) against Trie..." << endl;
+    StaticTrie staticTrie;
+    bool staticOk = staticTrie.size() == 0 && staticTrie.getAutoComplete("").empty();
+
+    vector<string> staticWords = radixWords;
+    staticWords.insert(staticWords.end(), testWords.begin(), testWords.end()); // duplicates collapse
+    staticTrie.build(staticWords);
+    staticOk = staticOk && staticTrie.size() == radix.size();
+    for (const char *prefix : {"", "a", "App", "apple ", "ban", "bandana", "c", "CA", "caf", "xyz", "z", "caf\xc3", "qq"})
+        staticOk = staticOk && staticTrie.getAutoComplete(prefix) == trie.getAutoComplete(prefix);
+    for (size_t i = 0; i < 200; i++)
+    {
+        const string &word = radixWords[radixWords.size() - 1 - i];
+        string prefix = word.substr(0, i % (word.size() + 1));
+        staticOk = staticOk && staticTrie.getAutoComplete(prefix) == trie.getAutoComplete(prefix);
+    }
+
+    staticTrie.build({"cat", "Catalog"});
+    staticOk = staticOk && staticTrie.size() == 2 && staticTrie.getAutoComplete("app").empty() &&
+               staticTrie.getAutoComplete("Ca") == vector<string>{"Cat", "Catalog"};
+
+    if (staticOk)
+    {
+        cout << "✓ StaticTrie: PASSED" << endl;
+        cout << "  - completions match Trie; rebuilding replaces the keys" << endl;
+    }
+    else
+    {
+        cout << "✗ StaticTrie: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.7: Top-K completions by weight, with and without a re-weighting
+    cout << "\n[3.7] Testing top-K ranked autocomplete..." << endl;
+    vector<string> rankedWords = generateRandomStrings(3000);
+    rankedWords.insert(rankedWords.end(), testWords.begin(), testWords.end());
+    sort(rankedWords.begin(), rankedWords.end());
+    rankedWords.erase(unique(rankedWords.begin(), rankedWords.end()), rankedWords.end());
+
+    vector<uint32_t> rankedWeights;
+    for (size_t i = 0; i < rankedWords.size(); i++)
+        rankedWeights.push_back((uint32_t)((i * 7919) % 100003) + 1); // distinct
+
+    RadixTrie rankedRadix;
+    StaticTrie rankedStatic, unweightedStatic;
+    for (size_t i = 0; i < rankedWords.size(); i++)
+    {
+        rankedRadix.insert(rankedWords[i]);
+        rankedRadix.setWeight(rankedWords[i], rankedWeights[i]);
+    }
+    rankedStatic.build(rankedWords, rankedWeights);
+    unweightedStatic.build(rankedWords);
+
+    auto bestK = [&](const string &prefix, int k)
+    {
+        vector<pair<uint32_t, string>> matches;
+        for (size_t i = 0; i < rankedWords.size(); i++)
+            if (rankedWords[i].compare(0, prefix.size(), prefix) == 0)
+                matches.emplace_back(rankedWeights[i], rankedWords[i]);
+        sort(matches.rbegin(), matches.rend());
+        vector<string> best;
+        for (int i = 0; i < k && i < (int)matches.size(); i++)
+            best.push_back(matches[i].second);
+        return best;
+    };
+
+    bool rankedOk = true;
+    for (const char *prefix : {"", "a", "b", "ca", "app", "zz", "q"})
+    {
+        for (int k : {1, 5, 20})
+        {
+            vector<string> expected = bestK(prefix, k);
+            vector<string> firstK = unweightedStatic.getAutoComplete(prefix);
+            firstK.resize(min(firstK.size(), expected.size()));
+            rankedOk = rankedOk && rankedRadix.getAutoComplete(prefix, k) == expected &&
+                       rankedStatic.getAutoComplete(prefix, k) == expected &&
+                       unweightedStatic.getAutoComplete(prefix, k) == firstK; // no weights: the first k in order
+        }
+    }
+
+    // Demote the best key everywhere; the next best takes its place
+    string demoted = bestK("", 1)[0];
+    for (size_t i = 0; i < rankedWords.size(); i++)
+        if (rankedWords[i] == demoted)
+            rankedWeights[i] = 0;
+    rankedOk = rankedOk && rankedRadix.setWeight(demoted, 0) && rankedStatic.setWeight(demoted, 0) &&
+               !rankedStatic.setWeight("not a key", 5) && rankedRadix.weightOf(demoted) == 0;
+    rankedOk = rankedOk && rankedRadix.getAutoComplete("", 10) == bestK("", 10) &&
+               rankedStatic.getAutoComplete("", 10) == bestK("", 10);
+
+    if (rankedOk)
+    {
+        cout << "✓ Top-K Autocomplete: PASSED" << endl;
+        cout << "  - RadixTrie and StaticTrie return the k heaviest completions, in order" << endl;
+    }
+    else
+    {
+        cout << "✗ Top-K Autocomplete: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.8: Paged completions through a cursor match the full list
+    cout << "\n[3.8] Testing paged autocomplete with a resume cursor..." << endl;
+    Trie pagedTrie;
+    for (const string &word : rankedWords)
+        pagedTrie.insert(word);
+
+    bool pagedOk = true;
+    TrieCursor cursor;
+    for (const char *prefix : {"", "a", "Ba", "app", "zz", "apple"})
+    {
+        vector<string> expected = pagedTrie.getAutoComplete(prefix);
+        for (size_t pageSize : {(size_t)1, (size_t)7, expected.size() ? expected.size() : 1})
+        {
+            vector<string> paged;
+            cursor.reset();
+            size_t pages = 0;
+            while (cursor.hasMore())
+            {
+                size_t emitted = pagedTrie.forEachCompletion(prefix, cursor, [&](const string &completion)
+                                                             { paged.push_back(completion); }, pageSize);
+                pagedOk = pagedOk && emitted <= pageSize && (emitted > 0 || expected.empty());
+                pages++;
+            }
+            pagedOk = pagedOk && paged == expected && pages == max((size_t)1, (expected.size() + pageSize - 1) / pageSize);
+        }
+    }
+
+    // Keys inserted between pages: those before the cursor are skipped, those after are returned
+    Trie growingTrie;
+    for (const char *word : {"cab", "cat", "cod", "cow"})
+        growingTrie.insert(word);
+    vector<string> growingPages;
+    cursor.reset();
+    growingTrie.forEachCompletion("c", cursor, [&](const string &completion)
+                                  { growingPages.push_back(completion); }, 2);
+    growingTrie.insert("ca");
+    growingTrie.insert("coat");
+    growingTrie.forEachCompletion("c", cursor, [&](const string &completion)
+                                  { growingPages.push_back(completion); });
+    pagedOk = pagedOk && growingPages == vector<string>{"cab", "cat", "coat", "cod", "cow"} && !cursor.hasMore();
+
+    // Once the cursor's buffers have grown, a query allocates nothing
+    size_t counted = 0;
+    auto countSink = [&](const string &completion)
+    { counted += completion.size(); };
+    cursor.reset();
+    pagedTrie.forEachCompletion("", cursor, countSink);
+    long long allocationsBefore = heapAllocations.load();
+    for (const char *prefix : {"", "a", "ca", "app"})
+    {
+        cursor.reset();
+        pagedTrie.forEachCompletion(prefix, cursor, countSink, 10);
+        pagedTrie.forEachCompletion(prefix, cursor, countSink, 10);
+    }
+    long long queryAllocations = heapAllocations.load() - allocationsBefore;
+    pagedOk = pagedOk && queryAllocations == 0;
+
+    if (pagedOk)
+    {
+        cout << "✓ Paged Autocomplete: PASSED" << endl;
+        cout << "  - pages join into the full list; resuming skips nothing, 0 allocations per query" << endl;
+    }
+    else
+    {
+        cout << "✗ Paged Autocomplete: FAILED (" << queryAllocations << " allocations)" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.9: Reference-counted removal in all three tries, against a multiset
+    cout << "\n[3.9] Testing remove with reference counts..." << endl;
+    map<string, int> references;
+    vector<string> inserted;
+    for (size_t i = 0; i < rankedWords.size(); i++)
+        for (size_t copies = 0; copies <= i % 3; copies++) // 1 to 3 references
+            inserted.push_back(rankedWords[i]);
+
+    Trie removalTrie;
+    RadixTrie removalRadix;
+    StaticTrie removalStatic;
+    for (const string &word : inserted)
+    {
+        removalTrie.insert(word);
+        removalRadix.insert(word);
+        references[word]++;
+    }
+    removalStatic.build(inserted);
+    size_t radixBytesFull = removalRadix.memoryBytes();
+
+    auto liveWords = [&](const string &prefix)
+    {
+        vector<string> live;
+        for (const pair<const string, int> &entry : references)
+            if (entry.second > 0 && entry.first.compare(0, prefix.size(), prefix) == 0)
+                live.push_back(entry.first);
+        return live;
+    };
+
+    // One reference from every word (single-reference words go), all of them from a third
+    bool removalOk = true;
+    for (size_t i = 0; i < rankedWords.size(); i++)
+    {
+        const string &word = rankedWords[i];
+        int drops = i % 3 == 2 ? references[word] : 1;
+        for (int d = 0; d < drops; d++)
+        {
+            removalOk = removalOk && removalTrie.remove(word) && removalRadix.remove(word) && removalStatic.remove(word);
+            references[word]--;
+        }
+    }
+    removalOk = removalOk && !removalTrie.remove(rankedWords[0]) && !removalRadix.remove(rankedWords[0]) &&
+                !removalStatic.remove(rankedWords[0]) && !removalTrie.remove("not a key");
+    for (const char *prefix : {"", "a", "b", "ca", "app", "q"})
+    {
+        vector<string> expected = liveWords(prefix);
+        removalOk = removalOk && removalTrie.getAutoComplete(prefix) == expected &&
+                    removalRadix.getAutoComplete(prefix) == expected && removalStatic.getAutoComplete(prefix) == expected;
+    }
+    removalOk = removalOk && removalRadix.size() == (int)liveWords("").size() && removalStatic.size() == removalRadix.size() &&
+                removalStatic.tombstones() == (int)(rankedWords.size() - liveWords("").size());
+    // Weights allocated after removals still cover the tombstones
+    removalOk = removalOk && removalStatic.setWeight(rankedWords[1], 7) && removalStatic.weightOf(rankedWords[1]) == 7 &&
+                !removalStatic.setWeight(rankedWords[0], 7) && removalStatic.getAutoComplete("", 1)[0] == rankedWords[1];
+
+    // Pruned branches: a full page ends the query, and the radix trie freed its nodes
+    TrieCursor removalCursor;
+    removalTrie.forEachCompletion("", removalCursor, [](const string &) {}, liveWords("").size());
+    removalOk = removalOk && !removalCursor.hasMore() && removalRadix.memoryBytes() < radixBytesFull;
+
+    // A removed key comes back with addRef (static) or insert
+    removalOk = removalOk && removalStatic.addRef(rankedWords[0]) && !removalStatic.addRef("not a key") &&
+                removalStatic.count(rankedWords[0]) == 1 && removalStatic.count(rankedWords[1]) == 1 &&
+                removalStatic.getAutoComplete(rankedWords[0])[0] == rankedWords[0];
+    removalTrie.insert(rankedWords[0]);
+    removalOk = removalOk && removalTrie.getAutoComplete(rankedWords[0])[0] == rankedWords[0];
+
+    // Sibling bytes 64 apart sit in different mask words ('0' and 'p', '-' and 'm');
+    // removing one must not prune the other
+    Trie siblingTrie;
+    for (const char *word : {"x0", "xp", "a-team", "am"})
+        siblingTrie.insert(word);
+    removalOk = removalOk && siblingTrie.remove("xp") && siblingTrie.getAutoComplete("x") == vector<string>{"x0"} &&
+                siblingTrie.remove("am") && siblingTrie.getAutoComplete("a") == vector<string>{"a-team"};
+
+    if (removalOk)
+    {
+        cout << "✓ Remove: PASSED" << endl;
+        cout << "  - " << removalStatic.tombstones() << " tombstones in the static trie; Trie and RadixTrie pruned their branches" << endl;
+    }
+    else
+    {
+        cout << "✗ Remove: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.10: Nodes come from the trie's slabs; clear() releases them all
+    cout << "\n[3.10] Testing slab-backed Trie nodes and clear()..." << endl;
+    set<string> prefixes;
+    for (const string &word : rankedWords)
+        for (size_t length = 1; length <= word.size(); length++)
+            prefixes.insert(word.substr(0, length));
+
+    bool arenaOk = true;
+    long long arenaAllocations = 0;
+    {
+        Trie arenaTrie;
+        for (int round = 0; round < 2; round++)
+        {
+            long long allocationsBefore = heapAllocations.load();
+            for (const string &word : rankedWords)
+                arenaTrie.insert(word);
+            arenaAllocations = heapAllocations.load() - allocationsBefore;
+            arenaOk = arenaOk && arenaTrie.getAutoComplete("") == rankedWords;
+
+            arenaTrie.clear();
+            arenaOk = arenaOk && arenaTrie.getAutoComplete("").empty() && !arenaTrie.remove(rankedWords[0]);
+        }
+        arenaTrie.insert("reused");
+        arenaOk = arenaOk && arenaTrie.getAutoComplete("re") == vector<string>{"reused"};
+    }
+    arenaOk = arenaOk && arenaAllocations * 16 < (long long)prefixes.size();
+
+    if (arenaOk)
+    {
+        cout << "✓ Trie Arena: PASSED" << endl;
+        cout << "  - " << prefixes.size() << " nodes from " << arenaAllocations << " heap allocations; clear() empties the trie" << endl;
+    }
+    else
+    {
+        cout << "✗ Trie Arena: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.11: Fuzzy completions against a brute-force edit distance over every key
+    cout << "\n[3.11] Testing typo-tolerant autocomplete..." << endl;
+    RadixTrie fuzzyRadix;
+    StaticTrie fuzzyStatic;
+    for (size_t i = 0; i < rankedWords.size(); i++)
+    {
+        fuzzyRadix.insert(rankedWords[i]);
+        fuzzyRadix.setWeight(rankedWords[i], rankedWeights[i]);
+    }
+    fuzzyStatic.build(rankedWords, rankedWeights);
+
+    // Edits to turn query into the closest prefix of word
+    auto prefixDistance = [](const string &query, const string &word)
+    {
+        vector<int> row(query.size() + 1), next(query.size() + 1);
+        for (size_t j = 0; j <= query.size(); j++)
+            row[j] = (int)j;
+        int best = row[query.size()];
+        for (char c : word)
+        {
+            next[0] = row[0] + 1;
+            for (size_t j = 1; j <= query.size(); j++)
+                next[j] = min({row[j - 1] + (query[j - 1] != c), row[j] + 1, next[j - 1] + 1});
+            row.swap(next);
+            best = min(best, row[query.size()]);
+        }
+        return best;
+    };
+    set<string> fuzzyRemoved;
+    auto bestFuzzy = [&](const string &query, int maxEdits, int k)
+    {
+        vector<tuple<int, int64_t, string>> matches;
+        for (size_t i = 0; i < rankedWords.size(); i++)
+        {
+            int distance = prefixDistance(query, rankedWords[i]);
+            if (distance <= maxEdits && !fuzzyRemoved.count(rankedWords[i]))
+                matches.emplace_back(distance, -(int64_t)rankedWeights[i], rankedWords[i]);
+        }
+        sort(matches.begin(), matches.end());
+        vector<string> best;
+        for (int i = 0; i < k && i < (int)matches.size(); i++)
+            best.push_back(get<2>(matches[i]));
+        return best;
+    };
+
+    // Misspelled prefixes of real keys: a swapped, a dropped and a doubled letter
+    vector<string> fuzzyQueries = {"", "x", "aple", "banan", "chrery", "qq"};
+    for (size_t i = 0; i < rankedWords.size(); i += 397)
+    {
+        string typo = rankedWords[i].substr(0, 6);
+        swap(typo[1], typo[2]);
+        fuzzyQueries.push_back(typo);
+        fuzzyQueries.push_back(rankedWords[i].substr(0, 2) + rankedWords[i].substr(3, 4));
+        fuzzyQueries.push_back(rankedWords[i].substr(0, 3) + rankedWords[i].substr(2, 4));
+    }
+
+    bool fuzzyOk = true;
+    int fuzzyChecked = 0;
+    for (int round = 0; round < 2; round++)
+    {
+        for (const string &query : fuzzyQueries)
+        {
+            for (int maxEdits : {0, 1, 2})
+            {
+                vector<string> expected = bestFuzzy(query, maxEdits, 10);
+                fuzzyOk = fuzzyOk && fuzzyRadix.getFuzzyAutoComplete(query, maxEdits, 10) == expected &&
+                          fuzzyStatic.getFuzzyAutoComplete(query, maxEdits, 10) == expected;
+                fuzzyChecked++;
+            }
+        }
+
+        // Second round: removed keys no longer match
+        for (size_t i = 0; i < rankedWords.size(); i += 5)
+        {
+            fuzzyRadix.remove(rankedWords[i]);
+            fuzzyStatic.remove(rankedWords[i]);
+            fuzzyRemoved.insert(rankedWords[i]);
+        }
+    }
+    // With no edits allowed it is the ranked autocomplete; uppercase input matches too
+    fuzzyOk = fuzzyOk && fuzzyStatic.getFuzzyAutoComplete("ca", 0, 5) == fuzzyStatic.getAutoComplete("ca", 5) &&
+              fuzzyRadix.getFuzzyAutoComplete("APLE", 1, 10) == fuzzyRadix.getFuzzyAutoComplete("aple", 1, 10) &&
+              fuzzyStatic.getFuzzyAutoComplete("aple", 1, 0).empty();
+
+    // Equal weights straddling the k-th slot keep the smallest titles, even
+    // when a heavier key opens its subtree ("bz") before the lighter ones
+    RadixTrie tieRadix;
+    StaticTrie tieStatic;
+    vector<string> tieWords = {"aa", "ab", "b", "bz"};
+    vector<uint32_t> tieWeights = {5, 5, 10, 5};
+    for (size_t i = 0; i < tieWords.size(); i++)
+    {
+        tieRadix.insert(tieWords[i]);
+        tieRadix.setWeight(tieWords[i], tieWeights[i]);
+    }
+    tieStatic.build(tieWords, tieWeights);
+    vector<string> tieExpected = {"b", "aa", "ab"};
+    fuzzyOk = fuzzyOk && tieRadix.getFuzzyAutoComplete("x", 1, 3) == tieExpected &&
+              tieStatic.getFuzzyAutoComplete("x", 1, 3) == tieExpected &&
+              tieRadix.getAutoComplete("", 3) == tieExpected && tieStatic.getAutoComplete("", 3) == tieExpected;
+
+    if (fuzzyOk)
+    {
+        cout << "✓ Fuzzy Autocomplete: PASSED" << endl;
+        cout << "  - " << fuzzyChecked << " queries ranked as a brute-force edit distance over every key" << endl;
+    }
+    else
+    {
+        cout << "✗ Fuzzy Autocomplete: FAILED" << endl;
+        allPassed = false;
+    }
+
+    // Test 3.12: Book IDs carried by trie keys, against a map of ID lists
+    cout << "\n[3.12] Testing book ID postings on trie keys..." << endl;
+    map<string, vector<int>> expectedIds;
+    vector<string> postedTitles;
+    vector<int> postedIds;
+    RadixTrie postingRadix;
+    StaticTrie postingStatic;
+    for (size_t i = 0; i < rankedWords.size(); i++)
+    {
+        for (size_t copies = 0; copies <= i % 3; copies++) // 1 to 3 books per title
+        {
+            int id = (int)(postedIds.size() * 7 + 1);
+            postedTitles.push_back(rankedWords[i]);
+            postedIds.push_back(id);
+            postingRadix.insert(rankedWords[i], id);
+            expectedIds[rankedWords[i]].push_back(id);
+        }
+    }
+    postingStatic.build(postedTitles, vector<uint32_t>(), postedIds);
+
+    auto sortedIds = [](vector<int> ids)
+    {
+        sort(ids.begin(), ids.end());
+        return ids;
+    };
+    auto idsMatch = [&]()
+    {
+        for (const pair<const string, vector<int>> &entry : expectedIds)
+        {
+            vector<int> expected = sortedIds(entry.second);
+            if (sortedIds(postingRadix.idsOf(entry.first)) != expected ||
+                sortedIds(postingStatic.idsOf(entry.first)) != expected ||
+                postingStatic.count(entry.first) != (int)expected.size())
+                return false;
+        }
+        return true;
+    };
+
+    // "appl" leads to keys without being one
+    bool postingOk = idsMatch() && postingStatic.idsOf("not a key").empty() && postingRadix.idsOf("not a key").empty() &&
+                     postingStatic.idsOf("appl").empty() && postingRadix.idsOf("appl").empty() &&
+                     !postingStatic.addRef("appl", 1) && !postingStatic.remove("appl", 1);
+
+    // Remove each title's first book; a book that does not have the title is refused
+    for (size_t i = 0; i < rankedWords.size(); i++)
+    {
+        vector<int> &ids = expectedIds[rankedWords[i]];
+        postingOk = postingOk && !postingStatic.remove(rankedWords[i], -1) && !postingRadix.remove(rankedWords[i], -1) &&
+                    postingStatic.remove(rankedWords[i], ids.front()) && postingRadix.remove(rankedWords[i], ids.front());
+        ids.erase(ids.begin());
+    }
+    postingOk = postingOk && idsMatch() && postingStatic.size() == postingRadix.size();
+
+    // A freed slot takes a new book; once the key is full it refuses one
+    string reused = rankedWords[0];
+    postingOk = postingOk && postingStatic.addRef(reused, 100000) && !postingStatic.addRef(reused, 100001);
+    postingRadix.insert(reused, 100000);
+    expectedIds[reused].push_back(100000);
+    postingOk = postingOk && idsMatch();
+
+    // A rebuild keeps the IDs of the live books
+    vector<string> rebuiltTitles;
+    vector<int> rebuiltIds;
+    for (const pair<const string, vector<int>> &entry : expectedIds)
+        for (int id : entry.second)
+        {
+            rebuiltTitles.push_back(entry.first);
+            rebuiltIds.push_back(id);
+        }
+    postingStatic.build(rebuiltTitles, vector<uint32_t>(), rebuiltIds);
+    postingOk = postingOk && idsMatch() && postingStatic.tombstones() == 0;
+
+    if (postingOk)
+    {
+        cout << "✓ Book ID Postings: PASSED" << endl;
+        cout << "  - " << postedIds.size() << " books on " << rankedWords.size()
+             << " titles; IDs follow adds and removes in both tries" << endl;
+    }
+    else
+    {
+        cout << "✗ Book ID Postings: FAILED" << endl;
+        allPassed = false;
+    }
+
+    cout << "\n"
+         << (allPassed ? "✓✓✓ Trie Test: ALL PASSED ✓✓✓" : "✗✗✗ Trie Test: SOME FAILED ✗✗✗") << endl;
+    return allPassed;
+}
+
+// === PERFORMANCE TESTS ===
+
+void PerformanceTest::benchmarkHashTable()
+{
+    cout << "\n\n=== PERFORMANCE BENCHMARK 1: Hash Table Operations ===" << endl;
+    cout << "Expected Complexity: O(1) average case for insert/search" << endl;
+    cout << "Testing on input sizes: 10³, 10⁴, 10⁵" << endl;
+
+    vector<int> sizes = {1000, 10000, 100000};
+
+    for (int size : sizes)
     {
         cout << "\n--- Testing with N = " << size << " books ---" << endl;
 
@@ -429,10 +1893,453 @@ void PerformanceTest::benchmarkHashTable()
         results.push_back(result);
     }
 
+    // Lookup cost scaling: a small payload lets the table reach 10⁷ entries.
+    // With load-factor resizing the per-lookup time should stay flat.
+    cout << "\n--- Lookup cost scaling (HashTable<int, int>, N = 10³ .. 10⁷) ---" << endl;
+    vector<int> scaleSizes = {1000, 10000, 100000, 1000000, 10000000};
+
+    for (int size : scaleSizes)
+    {
+        vector<double> searchTimes;
+        int buckets = 0;
+        double load = 0.0;
+
+        for (int run = 0; run < NUM_RUNS; run++)
+        {
+            HashTable<int, int> table;
+            for (int i = 1; i <= size; i++)
+                table.insert(i, i);
+
+            auto start = high_resolution_clock::now();
+            long long checksum = 0;
+            for (int i = 1; i <= size; i++)
+            {
+                int *v = table.search(i);
+                if (v)
+                    checksum += *v;
+            }
+            auto end = high_resolution_clock::now();
+            searchTimes.push_back(duration_cast<microseconds>(end - start).count() / 1000.0);
+
+            buckets = table.bucketCount();
+            load = table.loadFactor();
+            if (checksum == 0)
+                cout << "    (unexpected empty checksum)" << endl;
+        }
+
+        // Same lookups against the open-addressing table
+        vector<double> flatTimes;
+        for (int run = 0; run < NUM_RUNS; run++)
+        {
+            FlatHashTable<int, int> flat(size);
+            for (int i = 1; i <= size; i++)
+                flat.insert(i, i);
+
+            auto start = high_resolution_clock::now();
+            long long checksum = 0;
+            for (int i = 1; i <= size; i++)
+            {
+                int *v = flat.search(i);
+                if (v)
+                    checksum += *v;
+            }
+            auto end = high_resolution_clock::now();
+            flatTimes.push_back(duration_cast<microseconds>(end - start).count() / 1000.0);
+            if (checksum == 0)
+                cout << "    (unexpected empty checksum)" << endl;
+        }
+
+        double avgSearch = averageTimings(searchTimes);
+        double nsPerLookup = avgSearch * 1e6 / size;
+        double flatNsPerLookup = averageTimings(flatTimes) * 1e6 / size;
+
+        cout << "  N = " << setw(9) << size
+             << "  buckets = " << setw(9) << buckets
+             << "  load = " << fixed << setprecision(2) << load
+             << "  per lookup: " << setprecision(1) << nsPerLookup << " ns"
+             << "  (flat: " << flatNsPerLookup << " ns)" << endl;
+
+        TestResult result;
+        result.testName = "Hash Lookup Scaling (N=" + to_string(size) + ")";
+        result.inputSize = size;
+        result.averageTime = avgSearch;
+        result.passed = true;
+        result.expectedComplexity = "O(1) per lookup";
+        results.push_back(result);
+    }
+
+    // Node allocator: build, churn and tear down 10⁶ entries with per-node
+    // new/delete versus the slab allocator's free lists and bulk release
+    cout << "\n--- Node allocator (N = 10⁶, build / churn / destroy) ---" << endl;
+    const int allocN = 1000000;
+    double heapTimes[3] = {0, 0, 0};
+    double slabTimes[3] = {0, 0, 0};
+
+    for (int run = 0; run < NUM_RUNS; run++)
+    {
+        auto heapTable = new HashTable<int, int, HeapAllocator>();
+        auto slabTable = new HashTable<int, int, SlabAllocator>();
+
+        heapTimes[0] += measureTime([&]()
+                                    {
+                                        for (int i = 0; i < allocN; i++)
+                                            heapTable->insert(i, i);
+                                    });
+        slabTimes[0] += measureTime([&]()
+                                    {
+                                        for (int i = 0; i < allocN; i++)
+                                            slabTable->insert(i, i);
+                                    });
+
+        heapTimes[1] += measureTime([&]()
+                                    {
+                                        for (int i = 0; i < allocN; i++)
+                                        {
+                                            heapTable->remove(i);
+                                            heapTable->insert(i + allocN, i);
+                                        }
+                                    });
+        slabTimes[1] += measureTime([&]()
+                                    {
+                                        for (int i = 0; i < allocN; i++)
+                                        {
+                                            slabTable->remove(i);
+                                            slabTable->insert(i + allocN, i);
+                                        }
+                                    });
+
+        heapTimes[2] += measureTime([&]()
+                                    { delete heapTable; });
+        slabTimes[2] += measureTime([&]()
+                                    { delete slabTable; });
+    }
+
+    const char *phases[3] = {"Build  ", "Churn  ", "Destroy"};
+    for (int p = 0; p < 3; p++)
+    {
+        cout << "  " << phases[p] << "  heap: " << fixed << setprecision(3) << heapTimes[p] / NUM_RUNS << " ms"
+             << "  slab: " << slabTimes[p] / NUM_RUNS << " ms" << endl;
+    }
+
+    // Bucket distribution of the hash/reduction policies on ID patterns seen
+    // in real catalogs: sequential, strided (IDs reserved in blocks) and
+    // sparse with random gaps
+    cout << "\n--- Bucket distribution (N = 10⁵, max / p99 / mean chain) ---" << endl;
+    const int distN = 100000;
+    mt19937 gapGen(42);
+    uniform_int_distribution<> gapDist(1, 40);
+    vector<pair<string, vector<int>>> patterns(4);
+    patterns[0].first = "sequential";
+    patterns[1].first = "stride 64";
+    patterns[2].first = "stride 1000";
+    patterns[3].first = "random gaps";
+    int sparseId = 100000;
+    for (int i = 0; i < distN; i++)
+    {
+        patterns[0].second.push_back(i + 1);
+        patterns[1].second.push_back(i * 64);
+        patterns[2].second.push_back(i * 1000);
+        patterns[3].second.push_back(sparseId += gapDist(gapGen));
+    }
+
+    auto describe = [](const HashTableStats &st)
+    {
+        ostringstream out;
+        out << setw(4) << st.maxChain << " /" << setw(3) << st.p99Chain << " /" << fixed << setprecision(2) << setw(5) << st.meanChain;
+        return out.str();
+    };
+
+    cout << "  " << left << setw(13) << "IDs"
+         << "  " << setw(16) << "std % n"
+         << "  " << setw(16) << "std & mask"
+         << "  " << setw(16) << "mixed & mask"
+         << "  " << "mixed fastrange" << right << endl;
+    for (const auto &pattern : patterns)
+    {
+        HashTable<int, int> modulo;
+        HashTable<int, int, SlabAllocator, StdHash, MaskReduction> stdMask;
+        HashTable<int, int, SlabAllocator, MixedHash, MaskReduction> mixedMask;
+        HashTable<int, int, SlabAllocator, MixedHash, FastRangeReduction> mixedRange;
+        for (int id : pattern.second)
+        {
+            modulo.insert(id, id);
+            stdMask.insert(id, id);
+            mixedMask.insert(id, id);
+            mixedRange.insert(id, id);
+        }
+        cout << "  " << left << setw(13) << pattern.first << right
+             << "  " << describe(modulo.stats())
+             << "  " << describe(stdMask.stats())
+             << "  " << describe(mixedMask.stats())
+             << "  " << describe(mixedRange.stats()) << endl;
+    }
+
+    // Dense accession numbers: direct indexing versus hashing the same IDs
+    cout << "\n--- Dense IDs (N = 10⁶ books, ns per searchBook-style lookup) ---" << endl;
+    {
+        const int denseN = 1000000;
+        vector<Book> denseBooks = generateBooks(denseN);
+        vector<pair<int, Book>> hashRows, denseRows;
+        for (const Book &book : denseBooks)
+        {
+            hashRows.emplace_back(book.getId(), book);
+            denseRows.emplace_back(book.getId(), book);
+        }
+        HashTable<int, Book> hashed;
+        DenseIdTable<Book> dense;
+        hashed.bulkLoad(std::move(hashRows));
+        dense.bulkLoad(std::move(denseRows));
+
+        mt19937 probeGen(7);
+        uniform_int_distribution<> probeDist(1, denseN);
+        vector<int> probes(denseN);
+        for (int &probe : probes)
+            probe = probeDist(probeGen);
+
+        long long hashSum = 0, denseSum = 0;
+        double hashTime = measureTime([&]()
+                                      {
+                                          for (int id : probes)
+                                              hashSum += hashed.search(id)->getYear();
+                                      });
+        double denseTime = measureTime([&]()
+                                       {
+                                           for (int id : probes)
+                                               denseSum += dense.search(id)->getYear();
+                                       });
+
+        cout << "  HashTable: " << fixed << setprecision(1) << hashTime * 1e6 / denseN << " ns"
+             << "  DenseIdTable (" << (dense.isDirect() ? "direct" : "hashed") << "): "
+             << denseTime * 1e6 / denseN << " ns" << (hashSum == denseSum ? "" : "  (MISMATCH)") << endl;
+    }
+
+    // Lookups for IDs that do not exist: bucket walk versus Bloom filter
+    cout << "\n--- Miss-heavy lookups (N = 10⁶ books, 90% unknown IDs, ns per lookup) ---" << endl;
+    {
+        const int missN = 1000000;
+        vector<Book> missBooks = generateBooks(missN);
+        HashTable<int, Book> plain, filtered;
+        filtered.enableBloomFilter(0.01);
+        for (const Book &book : missBooks)
+        {
+            plain.insert(book.getId(), book);
+            filtered.insert(book.getId(), book);
+        }
+
+        mt19937 probeGen(11);
+        uniform_int_distribution<> probeDist(1, missN * 10);
+        vector<int> probes(missN);
+        for (int &probe : probes)
+            probe = probeDist(probeGen);
+
+        long long plainHits = 0, filteredHits = 0;
+        double plainTime = measureTime([&]()
+                                       {
+                                           for (int id : probes)
+                                               plainHits += plain.search(id) != nullptr;
+                                       });
+        long long skippedBefore = filtered.bloomSkippedProbes();
+        double filteredTime = measureTime([&]()
+                                          {
+                                              for (int id : probes)
+                                                  filteredHits += filtered.search(id) != nullptr;
+                                          });
+        long long skipped = filtered.bloomSkippedProbes() - skippedBefore;
+        long long misses = missN - filteredHits;
+
+        cout << "  No filter: " << fixed << setprecision(1) << plainTime * 1e6 / missN << " ns"
+             << "  Bloom 1%: " << filteredTime * 1e6 / missN << " ns"
+             << (plainHits == filteredHits ? "" : "  (MISMATCH)") << endl;
+        cout << "  " << skipped << " of " << misses << " misses skipped ("
+             << setprecision(2) << 100.0 * (misses - skipped) / misses << "% false positives), "
+             << filtered.bloomMemoryBytes() / 1024 << " KB filter" << endl;
+    }
+
+    // Catalog startup: row-by-row inserts versus one bulkLoad of the same rows
+    cout << "\n--- Bulk load (N = 10⁶ books, row-by-row vs bulkLoad) ---" << endl;
+    const int loadN = 1000000;
+    vector<Book> catalog = generateBooks(loadN);
+    double rowTime = 0, bulkTime = 0;
+
+    for (int run = 0; run < NUM_RUNS; run++)
+    {
+        vector<pair<int, Book>> rows;
+        rows.reserve(loadN);
+        for (const Book &book : catalog)
+            rows.emplace_back(book.getId(), book);
+
+        HashTable<int, Book> rowTable;
+        rowTime += measureTime([&]()
+                               {
+                                   for (const Book &book : catalog)
+                                       rowTable.insert(book.getId(), book);
+                               });
+
+        HashTable<int, Book> bulkTable;
+        bulkTime += measureTime([&]()
+                                { bulkTable.bulkLoad(std::move(rows)); });
+    }
+
+    cout << "  Row by row: " << fixed << setprecision(3) << rowTime / NUM_RUNS << " ms"
+         << "  bulkLoad: " << bulkTime / NUM_RUNS << " ms" << endl;
+
+    // Restart cost: rebuilding the table from parsed rows versus mapping a snapshot
+    cout << "\n--- Cold start (N = 10⁶ books, time to first query) ---" << endl;
+    {
+        const string snapshotFile = "benchmark_snapshot.bin";
+        BookSnapshotWriter writer;
+        for (const Book &book : catalog)
+            writer.add(book);
+        writer.write(snapshotFile);
+
+        int probeId = catalog[loadN / 2].getId();
+        bool rebuiltFound = false, mappedFound = false;
+
+        vector<pair<int, Book>> rows;
+        rows.reserve(loadN);
+        for (const Book &book : catalog)
+            rows.emplace_back(book.getId(), book);
+        HashTable<int, Book> rebuilt;
+        double rebuildTime = measureTime([&]()
+                                         {
+                                             rebuilt.bulkLoad(std::move(rows));
+                                             rebuiltFound = rebuilt.search(probeId) != nullptr;
+                                         });
+
+        BookSnapshot mapped;
+        double openTime = measureTime([&]()
+                                      {
+                                          mappedFound = mapped.open(snapshotFile) && mapped.find(probeId) != nullptr;
+                                      });
+
+        cout << "  bulkLoad + search: " << fixed << setprecision(3) << rebuildTime << " ms"
+             << "  open snapshot + find: " << openTime << " ms"
+             << (rebuiltFound && mappedFound ? "" : "  (NOT FOUND)") << endl;
+        remove(snapshotFile.c_str());
+    }
+
     cout << "\n✓ Hash Table maintains O(1) average case performance" << endl;
     cout << "  (Time per operation remains roughly constant as N increases)" << endl;
 }
 
+void PerformanceTest::benchmarkConcurrentHashTable()
+{
+    cout << "\n\n=== PERFORMANCE BENCHMARK 1b: Concurrent Hash Table ===" << endl;
+    cout << "95% search / 5% update on 10⁵ books, throughput per thread count" << endl;
+
+    const int bookCount = 100000;
+    const int opsPerThread = 200000;
+    vector<Book> books = generateBooks(bookCount);
+
+    ConcurrentHashTable<int, Book> striped;
+    HashTable<int, Book> single;
+    shared_mutex singleLock;
+    EpochHashTable<int, Book> epoch;
+    for (const Book &book : books)
+    {
+        striped.insert(book.getId(), book);
+        single.insert(book.getId(), book);
+        epoch.insert(book.getId(), book);
+    }
+
+    int maxThreads = max(4, (int)thread::hardware_concurrency());
+    vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    // Runs `threads` workers over the same op mix and returns total Mops/s
+    auto runMix = [&](int threads, auto readOp, auto writeOp)
+    {
+        vector<thread> workers;
+        auto start = high_resolution_clock::now();
+        for (int t = 0; t < threads; t++)
+        {
+            workers.emplace_back([&, t]()
+                                 {
+                                     mt19937 gen(t * 7919 + 1);
+                                     uniform_int_distribution<> keyDist(1, bookCount);
+                                     uniform_int_distribution<> opDist(0, 99);
+                                     Book copy;
+                                     int found = 0;
+                                     for (int i = 0; i < opsPerThread; i++)
+                                     {
+                                         int key = keyDist(gen);
+                                         if (opDist(gen) < 95)
+                                             found += readOp(key, copy);
+                                         else
+                                             writeOp(key, books[key - 1]);
+                                     }
+                                     if (found == 0)
+                                         cout << "    (unexpected: no hits)" << endl;
+                                 });
+        }
+        for (thread &worker : workers)
+            worker.join();
+        auto end = high_resolution_clock::now();
+        double ms = duration_cast<microseconds>(end - start).count() / 1000.0;
+        return (double)threads * opsPerThread / ms / 1000.0;
+    };
+
+    for (int threads : threadCounts)
+    {
+        double stripedRate = runMix(
+            threads,
+            [&](int key, Book &out)
+            { return striped.search(key, out); },
+            [&](int key, const Book &book)
+            { striped.update(key, book); });
+
+        double singleRate = runMix(
+            threads,
+            [&](int key, Book &out)
+            {
+                shared_lock<shared_mutex> guard(singleLock);
+                const HashTable<int, Book> &table = single;
+                const Book *val = table.search(key);
+                if (!val)
+                    return false;
+                out = *val;
+                return true;
+            },
+            [&](int key, const Book &book)
+            {
+                unique_lock<shared_mutex> guard(singleLock);
+                single.update(key, book);
+            });
+
+        double epochRate = runMix(
+            threads,
+            [&](int key, Book &out)
+            {
+                EpochGuard guard;
+                Book *val = epoch.search(key);
+                if (!val)
+                    return false;
+                out = *val;
+                return true;
+            },
+            [&](int key, const Book &book)
+            { epoch.update(key, book); });
+
+        cout << "  threads = " << setw(3) << threads
+             << "  striped: " << fixed << setprecision(2) << setw(7) << stripedRate << " Mops/s"
+             << "  single lock: " << setw(7) << singleRate << " Mops/s"
+             << "  epoch: " << setw(7) << epochRate << " Mops/s" << endl;
+
+        TestResult result;
+        result.testName = "Concurrent Hash 95/5 (threads=" + to_string(threads) + ")";
+        result.inputSize = threads;
+        result.averageTime = threads * opsPerThread / (stripedRate * 1000.0);
+        result.passed = true;
+        result.expectedComplexity = "O(1) per op, scales with threads";
+        results.push_back(result);
+    }
+
+    cout << "\n✓ Striped locking lets readers proceed in parallel on different stripes;" << endl;
+    cout << "  epoch-protected reads take no locks at all" << endl;
+}
+
 void PerformanceTest::benchmarkMergeSort()
 {
     cout << "\n\n=== PERFORMANCE BENCHMARK 2: Merge Sort ===" << endl;
@@ -513,6 +2420,9 @@ void PerformanceTest::benchmarkTrie()
 
         vector<double> insertTimes;
         vector<double> searchTimes;
+        vector<double> radixInsertTimes;
+        vector<double> radixSearchTimes;
+        long long trieBytes = 0, radixBytes = 0;
 
         for (int run = 0; run < NUM_RUNS; run++)
         {
@@ -520,6 +2430,7 @@ void PerformanceTest::benchmarkTrie()
 
             // Generate test data
             vector<string> words = generateRandomStrings(size);
+            long long bytesBefore = heapBytes.load();
             Trie trie;
 
             // Measure INSERT time
@@ -531,6 +2442,7 @@ void PerformanceTest::benchmarkTrie()
             auto end = high_resolution_clock::now();
             double insertTime = duration_cast<microseconds>(end - start).count() / 1000.0;
             insertTimes.push_back(insertTime);
+            trieBytes = heapBytes.load() - bytesBefore;
 
             // Measure AUTOCOMPLETE time (search first 100 prefixes)
             start = high_resolution_clock::now();
@@ -543,15 +2455,34 @@ void PerformanceTest::benchmarkTrie()
             end = high_resolution_clock::now();
             double searchTime = duration_cast<microseconds>(end - start).count() / 1000.0;
             searchTimes.push_back(searchTime);
+
+            // Same words and queries through the radix trie (live bytes: the
+            // heap counter would also count the label pool's old buffers)
+            RadixTrie radix;
+            radixInsertTimes.push_back(measureTime([&]()
+                                                   {
+                                                       for (const string &word : words)
+                                                           radix.insert(word); }));
+            radixBytes = (long long)radix.memoryBytes();
+
+            radixSearchTimes.push_back(measureTime([&]()
+                                                   {
+                                                       for (int i = 0; i < searchCount; i++)
+                                                           radix.getAutoComplete(words[i].substr(0, min(3, (int)words[i].length()))); }));
         }
 
         double avgInsert = averageTimings(insertTimes);
         double avgSearch = averageTimings(searchTimes);
+        double avgRadixInsert = averageTimings(radixInsertTimes);
+        double avgRadixSearch = averageTimings(radixSearchTimes);
 
         cout << "\n  Results for N = " << size << ":" << endl;
         cout << "    Insert time: " << fixed << setprecision(3) << avgInsert << " ms" << endl;
         cout << "    Autocomplete time (100 queries): " << fixed << setprecision(3) << avgSearch << " ms" << endl;
         cout << "    Avg time per insert: " << (avgInsert / size) << " ms" << endl;
+        cout << "    RadixTrie insert: " << avgRadixInsert << " ms, autocomplete (100 queries): " << avgRadixSearch << " ms" << endl;
+        cout << "    Memory: Trie " << setprecision(1) << (double)trieBytes / size << " bytes/key, RadixTrie "
+             << (double)radixBytes / size << " bytes/key" << endl;
 
         TestResult result;
         result.testName = "Trie (N=" + to_string(size) + ")";
@@ -562,6 +2493,179 @@ void PerformanceTest::benchmarkTrie()
         results.push_back(result);
     }
 
+    // Catalog-like titles: long keys sharing words and prefixes
+    int titleCount = 100000;
+    vector<Book> books = generateBooks(titleCount);
+    long long bytesBefore = heapBytes.load();
+    Trie titleTrie;
+    for (const Book &book : books)
+        titleTrie.insert(book.getTitle());
+    long long titleTrieBytes = heapBytes.load() - bytesBefore;
+
+    RadixTrie titleRadix;
+    for (const Book &book : books)
+        titleRadix.insert(book.getTitle());
+
+    cout << "\n--- Memory on " << titleCount << " catalog titles ---" << endl;
+    cout << "  Trie:      " << fixed << setprecision(1) << (double)titleTrieBytes / titleCount << " bytes/key" << endl;
+    cout << "  RadixTrie: " << (double)titleRadix.memoryBytes() / titleCount << " bytes/key" << endl;
+
+    vector<string> titles;
+    for (const Book &book : books)
+        titles.push_back(book.getTitle());
+    StaticTrie titleStatic;
+    double buildTime = measureTime([&]()
+                                   { titleStatic.build(titles); });
+    cout << "  StaticTrie: " << (double)titleStatic.memoryBytes() / titleCount << " bytes/key, "
+         << (double)titleStatic.memoryBytes() / titleStatic.nodeCount() << " bytes/node (built in "
+         << setprecision(3) << buildTime << " ms)" << endl;
+
+    // Narrow prefixes, as typed into the search box near the end of a title
+    vector<string> queries;
+    for (int i = 0; i < 1000; i++)
+    {
+        const string &title = titles[(i * 7919) % titleCount];
+        queries.push_back(title.substr(0, title.size() - 1));
+    }
+    size_t radixHits = 0, staticHits = 0;
+    double radixQueryTime = measureTime([&]()
+                                        {
+                                            for (const string &query : queries)
+                                                radixHits += titleRadix.getAutoComplete(query).size(); });
+    double staticQueryTime = measureTime([&]()
+                                         {
+                                             for (const string &query : queries)
+                                                 staticHits += titleStatic.getAutoComplete(query).size(); });
+    cout << "  Autocomplete (1000 queries): RadixTrie " << radixQueryTime << " ms, StaticTrie " << staticQueryTime
+         << " ms" << (radixHits == staticHits ? "" : " (MISMATCH)") << endl;
+
+    // One-letter prefixes match a large share of the catalog; ranked top-10
+    // stops after ten keys instead of listing every completion
+    vector<uint32_t> titleWeights;
+    for (int i = 0; i < titleCount; i++)
+        titleWeights.push_back((uint32_t)((i * 2654435761u) % 1000));
+    titleStatic.build(titles, titleWeights);
+    for (int i = 0; i < titleCount; i++)
+        titleRadix.setWeight(titles[i], titleWeights[i]);
+
+    const int keystrokes = 100;
+    size_t allCount = 0;
+    double allTime = measureTime([&]()
+                                 {
+                                     for (int i = 0; i < keystrokes; i++)
+                                         allCount += titleStatic.getAutoComplete(titles[i].substr(0, 1)).size(); });
+    double staticTopTime = measureTime([&]()
+                                       {
+                                           for (int i = 0; i < keystrokes; i++)
+                                               titleStatic.getAutoComplete(titles[i].substr(0, 1), 10); });
+    double radixTopTime = measureTime([&]()
+                                      {
+                                          for (int i = 0; i < keystrokes; i++)
+                                              titleRadix.getAutoComplete(titles[i].substr(0, 1), 10); });
+    cout << "  One-letter prefix (" << allCount / keystrokes << " completions on average): all "
+         << allTime * 1000 / keystrokes << " us, top-10 StaticTrie " << staticTopTime * 1000 / keystrokes
+         << " us, top-10 RadixTrie " << radixTopTime * 1000 / keystrokes << " us per keystroke" << endl;
+
+    // Allocations per query: getAutoComplete() copies every completion into
+    // a new vector; a reused cursor streams them from one path buffer
+    TrieCursor cursor;
+    size_t streamed = 0;
+    auto countSink = [&](const string &completion)
+    { streamed += completion.size(); };
+    titleTrie.forEachCompletion("", cursor, countSink, 1); // size the buffers
+    long long allocationsBefore = heapAllocations.load();
+    double listTime = measureTime([&]()
+                                  {
+                                      for (const string &query : queries)
+                                          titleTrie.getAutoComplete(query); });
+    double listAllocations = (double)(heapAllocations.load() - allocationsBefore) / queries.size();
+    allocationsBefore = heapAllocations.load();
+    double streamTime = measureTime([&]()
+                                    {
+                                        for (const string &query : queries)
+                                        {
+                                            cursor.reset();
+                                            titleTrie.forEachCompletion(query, cursor, countSink);
+                                        } });
+    double streamAllocations = (double)(heapAllocations.load() - allocationsBefore) / queries.size();
+    cout << "  Trie autocomplete (1000 queries): vector " << listTime << " ms, " << setprecision(1) << listAllocations
+         << " allocations/query; cursor " << setprecision(3) << streamTime << " ms, " << setprecision(1)
+         << streamAllocations << " allocations/query" << endl;
+
+    // First page of 10 for a one-letter prefix, then the next page
+    double pageTime = measureTime([&]()
+                                  {
+                                      for (int i = 0; i < keystrokes; i++)
+                                      {
+                                          cursor.reset();
+                                          titleTrie.forEachCompletion(titles[i].substr(0, 1), cursor, countSink, 10);
+                                          titleTrie.forEachCompletion(titles[i].substr(0, 1), cursor, countSink, 10);
+                                      } });
+    cout << "  Two pages of 10 for a one-letter prefix: " << setprecision(3) << pageTime * 1000 / keystrokes
+         << " us per keystroke" << endl;
+
+    // Renaming a title in place (tombstone in the static trie, key in the
+    // delta) against re-indexing the whole catalog
+    const int renames = 1000;
+    double renameTime = measureTime([&]()
+                                    {
+                                        for (int i = 0; i < renames; i++)
+                                        {
+                                            titleStatic.remove(titles[i]);
+                                            titleRadix.insert(titles[i] + " (2nd ed)");
+                                        } });
+    double rebuildTime = measureTime([&]()
+                                     { titleStatic.build(titles); });
+    cout << "  Rename a title: " << setprecision(3) << renameTime * 1000 / renames << " us in place, "
+         << rebuildTime << " ms to rebuild the catalog trie" << endl;
+
+    // Nightly reload: drop the whole title trie and build it again
+    double clearTime = measureTime([&]()
+                                   { titleTrie.clear(); });
+    allocationsBefore = heapAllocations.load();
+    long long reloadBytesBefore = heapBytes.load();
+    double reloadTime = measureTime([&]()
+                                    {
+                                        for (const string &title : titles)
+                                            titleTrie.insert(title); });
+    long long reloadAllocations = heapAllocations.load() - allocationsBefore;
+    cout << "  Reload " << titleCount << " titles into Trie: clear " << setprecision(3) << clearTime << " ms, rebuild "
+         << reloadTime << " ms in " << reloadAllocations << " heap allocations of " << setprecision(1)
+         << (double)(heapBytes.load() - reloadBytesBefore) / reloadAllocations / 1024 << " KB on average" << endl;
+
+    // Typo-tolerant top-10 on a million titles: a misspelled prefix, one
+    // or two edits allowed. Branches are cut once the edit budget runs out
+    // and matching subtrees are ranked best-first, so the cost follows the
+    // typed prefix and k rather than the catalog size.
+    const int fuzzyCount = 1000000;
+    vector<string> fuzzyTitles;
+    vector<uint32_t> fuzzyWeights;
+    for (const Book &book : generateBooks(fuzzyCount))
+        fuzzyTitles.push_back(book.getTitle());
+    for (int i = 0; i < fuzzyCount; i++)
+        fuzzyWeights.push_back((uint32_t)((i * 2654435761u) % 1000));
+    StaticTrie fuzzyStatic;
+    fuzzyStatic.build(fuzzyTitles, fuzzyWeights);
+
+    vector<string> typos;
+    for (int i = 0; i < 1000; i++)
+    {
+        string typo = fuzzyTitles[(i * 7919) % fuzzyCount].substr(0, 6 + i % 10);
+        typo[2 + i % 4] = 'x';
+        typos.push_back(typo);
+    }
+    for (int maxEdits : {1, 2})
+    {
+        size_t fuzzyHits = 0;
+        double fuzzyTime = measureTime([&]()
+                                       {
+                                           for (const string &typo : typos)
+                                               fuzzyHits += fuzzyStatic.getFuzzyAutoComplete(typo, maxEdits, 10).size(); });
+        cout << "  Fuzzy top-10 on " << fuzzyCount << " titles, " << maxEdits << " edit(s): " << setprecision(3)
+             << fuzzyTime * 1000 / typos.size() << " us per query (" << setprecision(1)
+             << (double)fuzzyHits / typos.size() << " results on average)" << endl;
+    }
+
     cout << "\n✓ Trie maintains O(m) performance per operation" << endl;
     cout << "  (Time depends on string length, not dataset size)" << endl;
 }
@@ -652,6 +2756,212 @@ void PerformanceTest::benchmarkSearch()
 
     cout << "\n✓ Hash-based search significantly outperforms linear search" << endl;
     cout << "  (Speedup increases with dataset size)" << endl;
+
+    // Substring search by title: every title scanned, or the trigram index's
+    // candidates confirmed one by one (as BookManager::searchBookByTitle does)
+    cout << "\n--- Title substring search, N = 100000 books ---" << endl;
+    vector<Book> titleBooks = generateBooks(100000);
+    vector<string> lowerTitles;
+    TrigramIndex titleIndex;
+    for (const Book &book : titleBooks)
+    {
+        string title = book.getTitle();
+        transform(title.begin(), title.end(), title.begin(), ::tolower);
+        lowerTitles.push_back(title);
+        titleIndex.add(book.getId(), title);
+    }
+    vector<string> titleTerms = {"ocean depths vol 1234", "vol 9999", "tales vol 42", "wisdom vol 7777", "journey"};
+
+    size_t scanMatches = 0, indexMatches = 0;
+    auto start = high_resolution_clock::now();
+    for (const string &term : titleTerms)
+        for (const string &title : lowerTitles)
+            scanMatches += title.find(term) != string::npos;
+    double scanTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+
+    vector<int> candidateIds;
+    start = high_resolution_clock::now();
+    for (const string &term : titleTerms)
+    {
+        titleIndex.candidates(term, candidateIds);
+        for (int id : candidateIds)
+            indexMatches += lowerTitles[id - 1].find(term) != string::npos;
+    }
+    double indexTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+
+    cout << "  " << titleTerms.size() << " terms, " << scanMatches << " matches" << endl;
+    cout << "    Full scan:     " << fixed << setprecision(3) << scanTime << " ms" << endl;
+    cout << "    Trigram index: " << fixed << setprecision(3) << indexTime << " ms"
+         << (indexMatches == scanMatches ? "" : " (MISMATCH)") << endl;
+    cout << "    Index size:    " << titleIndex.trigramCount() << " trigrams, "
+         << titleIndex.memoryBytes() / 1024 << " KB" << endl;
+
+    TestResult titleResult;
+    titleResult.testName = "Title Substring Search (N=100000)";
+    titleResult.inputSize = 100000;
+    titleResult.averageTime = indexTime;
+    titleResult.passed = indexMatches == scanMatches;
+    titleResult.expectedComplexity = "O(candidates) vs O(n)";
+    results.push_back(titleResult);
+}
+
+void PerformanceTest::benchmarkHistoryReplay()
+{
+    cout << "\n\n=== PERFORMANCE BENCHMARK 5: Borrow History Replay ===" << endl;
+    cout << "Expected Complexity: O(n) to append n records, O(n) to walk them" << endl;
+    cout << "Testing on input sizes: 10⁴, 10⁵, 10⁶ (LinkedList of lines vs HistoryLog)" << endl;
+
+    // 5000 users, 20000 titles, a year of dates, as in a real borrow_records.csv
+    vector<string> users, titles, dates;
+    for (int i = 0; i < 5000; i++)
+        users.push_back("user" + to_string(i));
+    for (int i = 0; i < 20000; i++)
+        titles.push_back("Book Title Number " + to_string(i));
+    for (int i = 0; i < 365; i++)
+        dates.push_back("2025-" + to_string(10 + i / 31) + "-" + to_string(10 + i % 31));
+
+    vector<int> sizes = {10000, 100000, 1000000};
+
+    for (int size : sizes)
+    {
+        cout << "\n--- Testing with N = " << size << " history records ---" << endl;
+
+        vector<double> listTimes, logTimes, walkTimes;
+        long long listBytes = 0, logBytes = 0;
+        int returns = 0;
+
+        for (int run = 0; run < NUM_RUNS; run++)
+        {
+            auto action = [](int i)
+            { return i % 2 ? "return" : "borrow"; };
+
+            // Previous representation: one node and one line string per event
+            long long bytesBefore = heapBytes.load();
+            LinkedList<string> lines;
+            listTimes.push_back(measureTime([&]()
+                                            {
+                                                for (int i = 0; i < size; i++)
+                                                    lines.insertAtEnd(users[i % 5000] + "," + titles[(i / 2) % 20000] + "," +
+                                                                      dates[(i / 2) % 365] + "," + action(i));
+                                            }));
+            listBytes = heapBytes.load() - bytesBefore;
+
+            bytesBefore = heapBytes.load();
+            HistoryLog log;
+            logTimes.push_back(measureTime([&]()
+                                           {
+                                               for (int i = 0; i < size; i++)
+                                                   log.append(users[i % 5000], titles[(i / 2) % 20000], dates[(i / 2) % 365], action(i));
+                                           }));
+            logBytes = heapBytes.load() - bytesBefore;
+
+            // Most recent first, as the history view shows it
+            returns = 0;
+            walkTimes.push_back(measureTime([&]()
+                                            {
+                                                for (auto it = log.rbegin(); it != log.rend(); ++it)
+                                                    returns += (*it).action == "return";
+                                            }));
+        }
+
+        double avgList = averageTimings(listTimes);
+        double avgLog = averageTimings(logTimes);
+        double avgWalk = averageTimings(walkTimes);
+
+        cout << "\n  Results for N = " << size << ":" << endl;
+        cout << "    LinkedList append: " << fixed << setprecision(3) << avgList << " ms ("
+             << setprecision(1) << avgList * 1e6 / size << " ns, " << (double)listBytes / size << " bytes per record)" << endl;
+        cout << "    HistoryLog append: " << setprecision(3) << avgLog << " ms ("
+             << setprecision(1) << avgLog * 1e6 / size << " ns, " << (double)logBytes / size << " bytes per record)" << endl;
+        cout << "    HistoryLog walk, newest first: " << setprecision(3) << avgWalk << " ms (" << returns << " returns)" << endl;
+
+        TestResult result;
+        result.testName = "History Replay (N=" + to_string(size) + ")";
+        result.inputSize = size;
+        result.averageTime = avgLog;
+        result.passed = returns == size / 2;
+        result.expectedComplexity = "O(n)";
+        results.push_back(result);
+    }
+
+    cout << "\n✓ Appending to the history costs the same per record at every size" << endl;
+    cout << "  (HistoryLog stores 12-byte events over interned strings)" << endl;
+
+    // Returning a loan: scan the user's list of "title|date" lines for the
+    // title, or look the loan up by (user, title) and unlink it
+    cout << "\n--- Loan return latency by active loans per user ---" << endl;
+    mt19937 gen(42);
+    for (int loansPerUser : {10, 100, 1000})
+    {
+        vector<int> returnOrder(loansPerUser);
+        for (int i = 0; i < loansPerUser; i++)
+            returnOrder[i] = i;
+        shuffle(returnOrder.begin(), returnOrder.end(), gen);
+
+        vector<double> scanTimes, unlinkTimes;
+        bool allReturned = true;
+        for (int run = 0; run < NUM_RUNS; run++)
+        {
+            LinkedList<string> lines;
+            for (int i = 0; i < loansPerUser; i++)
+                lines.insertAtEnd(titles[i] + "|" + dates[i % 365]);
+
+            scanTimes.push_back(measureTime([&]()
+                                            {
+                                                for (int i : returnOrder)
+                                                {
+                                                    for (const string &line : lines)
+                                                    {
+                                                        if (string_view(line).substr(0, line.find('|')) == titles[i])
+                                                        {
+                                                            string match = line;
+                                                            lines.remove(match);
+                                                            break;
+                                                        }
+                                                    }
+                                                } }));
+
+            vector<Loan> loans;
+            loans.reserve(loansPerUser);
+            LoanList userLoans(BY_USER), bookLoans(BY_BOOK);
+            HashTable<string, Loan *> index;
+            for (int i = 0; i < loansPerUser; i++)
+            {
+                loans.emplace_back("power user", titles[i], dates[i % 365]);
+                userLoans.pushBack(&loans.back());
+                bookLoans.pushBack(&loans.back());
+                index.insert("power user\x1f" + titles[i], &loans.back());
+            }
+
+            unlinkTimes.push_back(measureTime([&]()
+                                              {
+                                                  for (int i : returnOrder)
+                                                  {
+                                                      string key = "power user\x1f" + titles[i];
+                                                      Loan *loan = *index.search(key);
+                                                      index.remove(key);
+                                                      userLoans.unlink(loan);
+                                                      bookLoans.unlink(loan);
+                                                  } }));
+
+            allReturned = allReturned && lines.empty() && userLoans.empty() && index.size() == 0;
+        }
+
+        double avgScan = averageTimings(scanTimes);
+        double avgUnlink = averageTimings(unlinkTimes);
+        cout << "  " << loansPerUser << " loans: list scan " << fixed << setprecision(1) << avgScan * 1e6 / loansPerUser
+             << " ns, index + unlink " << avgUnlink * 1e6 / loansPerUser << " ns per return" << endl;
+
+        TestResult result;
+        result.testName = "Loan Return (loans=" + to_string(loansPerUser) + ")";
+        result.inputSize = loansPerUser;
+        result.averageTime = avgUnlink;
+        result.passed = allReturned;
+        result.expectedComplexity = "O(1) per return";
+        results.push_back(result);
+    }
+
+    cout << "\n✓ Return cost no longer grows with the number of loans a user holds" << endl;
 }
 
 // === REPORTING ===
@@ -735,9 +3045,11 @@ void PerformanceTest::runAllTests()
     cout << "\n\n========== PHASE 2: PERFORMANCE BENCHMARKS ==========" << endl;
 
     benchmarkHashTable();
+    benchmarkConcurrentHashTable();
     benchmarkMergeSort();
     benchmarkTrie();
     benchmarkSearch();
+    benchmarkHistoryReplay();
 
     printResults();
     generateReport("performance_report.txt");
@@ -81,11 +81,21 @@ public:
 
     /**
      * @brief Performance Test 1: Hash Table Operations
-     * Tests insert and search on N = 10³, 10⁴, 10⁵
+     * Tests insert and search on N = 10³, 10⁴, 10⁵, then per-lookup
+     * cost on a resizing table from 10³ up to 10⁷ entries
      * Expected: O(1) average case for insert and search
      */
     void benchmarkHashTable();
 
+    /**
+     * @brief Performance Test 1b: Concurrent Hash Table
+     * Read throughput from 1 to N threads under a 95/5 read/write mix on
+     * 10⁵ books: lock-striped table, a single table behind one lock, and
+     * the epoch-protected table with lock-free reads
+     * Expected: striped and epoch throughput grow with threads, single lock flattens
+     */
+    void benchmarkConcurrentHashTable();
+
     /**
      * @brief Performance Test 2: Merge Sort
      * Tests sorting on N = 10³, 10⁴, 10⁵
@@ -95,7 +105,8 @@ public:
 
     /**
      * @brief Performance Test 3: Trie Operations
-     * Tests insert and autocomplete on N = 10³, 10⁴, 10⁵
+     * Tests insert and autocomplete on N = 10³, 10⁴, 10⁵ for Trie and RadixTrie,
+     * and reports the bytes per key of both layouts
      * Expected: O(m) where m is length of string/prefix
      */
     void benchmarkTrie();
@@ -107,6 +118,14 @@ public:
      */
     void benchmarkSearch();
 
+    /**
+     * @brief Performance Test 5: Borrow History Replay
+     * Appends N = 10⁴, 10⁵, 10⁶ history records to a LinkedList and walks them,
+     * then times loan returns for users holding 10, 100 and 1000 loans
+     * Expected: O(n) in total, i.e. constant time per appended record; O(1) per return
+     */
+    void benchmarkHistoryReplay();
+
     // Reporting
     void printResults();
     void generateReport(const string &filename);